@@ -0,0 +1,50 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <vector>
+
+namespace libaudioverse_implementation {
+
+/**Many independent biquads in transposed direct form 2, each with its own coefficients and history.
+
+Coefficients and state are stored as structures of arrays with one lane per filter.
+Processing runs 4 lanes at once in single precision or 2 lanes at once in double precision, so this is fastest when there are at least that many lanes.
+Lanes are usually channels, but needn't be: any set of mono filters which are processed together can share a bank.*/
+class BiquadBank {
+	public:
+	BiquadBank(float sr, int lanes = 1, bool doublePrecision = false);
+	int getLaneCount();
+	//Existing lanes keep their coefficients and history; new lanes are identity filters.
+	void setLaneCount(int lanes);
+	bool getDoublePrecision();
+	//Carries history over.
+	void setDoublePrecision(bool doublePrecision);
+
+	void configure(int lane, int type, double frequency, double dbGain, double q);
+	//Configure every lane the same way.
+	void configureAll(int type, double frequency, double dbGain, double q);
+	void setCoefficients(int lane, double b0, double b1, double b2, double a1, double a2);
+	void reset();
+	void reset(int lane);
+	//Copy a lane's coefficients and history from one bank to another, converting the history to the destination's precision.
+	//This is how filters living in different places are gathered into one bank and scattered back.
+	static void copyLane(BiquadBank &from, int fromLane, BiquadBank &to, int toLane);
+
+	//Inputs and outputs hold one buffer per lane, and may be the same buffers.
+	void process(int blockSize, float** inputs, float** outputs);
+	private:
+	void processFloat(int blockSize, float** inputs, float** outputs);
+	void processDouble(int blockSize, float** inputs, float** outputs);
+	float sr;
+	int lanes = 0;
+	bool double_precision = false;
+	//Coefficients are always kept in double precision, with single precision copies for the float path.
+	std::vector<double> b0, b1, b2, a1, a2;
+	std::vector<float> b0f, b1f, b2f, a1f, a2f;
+	//History; only the set matching the current precision is in use.
+	std::vector<double> s1, s2;
+	std::vector<float> s1f, s2f;
+};
+
+}
@@ -0,0 +1,65 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include "../libaudioverse_properties.h"
+#include <memory>
+
+namespace libaudioverse_implementation {
+
+class Buffer;
+
+/**Plays a buffer at a variable rate, for the buffer and buffer timeline nodes.
+
+At a rate of exactly 1 with the position on a sample, this copies straight out of the buffer.
+Otherwise it interpolates with one of the Lav_INTERPOLATION_TYPES.
+Positions and weights are worked out once per block and shared by all channels, and the interpolation itself is SIMD over 4 output samples at a time.
+
+Process writes every sample of every output, including silence, so outputs don't need zeroing first.
+With add set, it mixes into the outputs instead.
+Start is where in the block playback begins, for sample-accurate scheduling; only frames from start on are written, and the player advances by block_size-start frames.*/
+class BufferPlayer {
+	public:
+	BufferPlayer(int blockSize, float sr);
+	~BufferPlayer();
+	void process(int channels, float** outputs, bool add = false, int start = 0);
+	//Handles the buffer's use count.
+	void setBuffer(std::shared_ptr<Buffer> buffer);
+	std::shared_ptr<Buffer> getBuffer();
+	int getEndedCount();
+	void resetEndedCount();
+	bool getIsLooping();
+	void setIsLooping(bool looping);
+	double getRate();
+	void setRate(double rate);
+	//In seconds.
+	double getPosition();
+	void setPosition(double position);
+	int getInterpolation();
+	void setInterpolation(int interpolation);
+	private:
+	//Copy source frames [start, start+count) of one channel into destination, wrapping if looping and zero outside the buffer otherwise.
+	void readWindow(int channel, int start, int count, float* destination);
+	void processCopy(int channels, float** outputs, bool add, int start);
+	void processInterpolated(int channels, float** outputs, bool add, int start);
+	//Interpolates count outputs from start, which must fit in the window.
+	void processInterpolatedRange(int channels, float** outputs, bool add, int start, int count);
+	std::shared_ptr<Buffer> buffer = nullptr;
+	int buffer_frames = 0, buffer_channels = 0;
+	int block_size = 0;
+	float sr = 0.0f;
+	//In frames.
+	double position = 0.0;
+	double rate = 1.0;
+	bool is_looping = false;
+	int ended_count = 0;
+	int interpolation = Lav_INTERPOLATION_TYPE_LINEAR;
+	//Per block: where each output sample falls in the window, shared by all channels.
+	int* indices = nullptr;
+	float* fractions = nullptr;
+	//Source samples for one channel.  Never reallocated, so processing doesn't allocate.
+	float* window = nullptr;
+	int window_length = 0;
+};
+
+}
@@ -3,6 +3,9 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
 #include <kiss_fftr.h>
+#include "fft.hpp"
+#include <vector>
+#include <memory>
 
 namespace libaudioverse_implementation {
 
@@ -21,15 +24,35 @@ class BlockConvolver {
 	int block_size = 0, response_length = 0;
 };
 
+/**The fft of an impulse response, padded for use with FftConvolvers of a specific block size.
+
+These are immutable once constructed, so that many convolvers can share one.  See response_cache.hpp.*/
+class ResponseSpectrum {
+	public:
+	ResponseSpectrum(int length, float* response, int blockSize);
+	~ResponseSpectrum();
+	int getLength();
+	int getBlockSize();
+	//The size of the transform, which convolvers using this spectrum must match.
+	int getFftSize();
+	int getBinCount();
+	const kiss_fft_cpx* getBins();
+	private:
+	int length = 0, block_size = 0, fft_size = 0;
+	kiss_fft_cpx* bins = nullptr;
+};
+
 class FftConvolver {
 	public:
 	FftConvolver(int blockSize);
 	~FftConvolver();
 	void setResponse(int length, float* response);
+	//The spectrum's block size must match ours.
+	void setResponseSpectrum(std::shared_ptr<ResponseSpectrum> spectrum);
 	void convolve(float* input, float* output);
 	//Convolve with an fft of the input.
 	//This fft must meet a size requirement, queerieable by getFftSize().
-	//Must be computed with kiss_fftr.
+	//Must be in the format produced by RealFft, which matches kiss_fftr.
 	void convolveFft(kiss_fft_cpx *fft, float* output);
 	//If using convolveFft, this is the size to which the input must be zero-padded.
 	int getFftSize();
@@ -41,8 +64,40 @@ class FftConvolver {
 	private:
 	int block_size = 0, fft_size = 0, tail_size= 0, workspace_size = 0;
 	float*workspace = nullptr, *tail = nullptr;
-	kiss_fft_cpx *response_fft = nullptr, *block_fft = nullptr;
-	kiss_fftr_cfg fft = nullptr, ifft = nullptr;
+	kiss_fft_cpx *block_fft = nullptr;
+	std::shared_ptr<ResponseSpectrum> response_spectrum = nullptr;
+	RealFft *real_fft = nullptr;
+};
+
+/**Convolves n inputs with m outputs, where every input/output pair has its own response.
+
+Each input is transformed once per block, the products for every output are accumulated in the frequency domain, and then each output needs one inverse fft.
+All pairs share one fft size, computed from the longest response.
+A pair with an empty response is not connected, and costs nothing.*/
+class FftMatrixConvolver {
+	public:
+	//By default, input i is connected to output i with a unit impulse.
+	FftMatrixConvolver(int blockSize, int inputCount, int outputCount);
+	~FftMatrixConvolver();
+	//A length of 0 disconnects the pair.
+	//If this changes the fft size, the history is zeroed.
+	void setResponse(int input, int output, int length, float* response);
+	void convolve(float** inputs, float** outputs);
+	void reset();
+	int getInputCount();
+	int getOutputCount();
+	private:
+	void computeResponseFft(int index);
+	int block_size = 0, input_count = 0, output_count = 0, fft_size = 0, tail_size = 0, workspace_size = 0;
+	//Indexed by input*output_count+output.
+	std::vector<std::vector<float>> responses;
+	//Null for unconnected pairs.
+	std::vector<kiss_fft_cpx*> response_ffts;
+	std::vector<kiss_fft_cpx*> input_ffts;
+	std::vector<float*> tails;
+	kiss_fft_cpx *accumulator = nullptr;
+	float *workspace = nullptr;
+	RealFft *real_fft = nullptr;
 };
 
 }
\ No newline at end of file
@@ -18,6 +18,14 @@ class DelayRingbuffer {
 	void advance(float sample);
 	void write(unsigned int offset, float value);
 	void add(unsigned int index, float value);
+	/**Block versions of the above, each of which is at most two contiguous spans of the buffer.
+	readBlock gives read(offset), read(offset-1), ... read(offset-length+1): what read(offset) would give over the next length advances, were nothing written.
+	mixBlock adds the same samples times weight to output, so that interpolating between two reads needs no temporary.
+	writeBlock is length calls to advance, and addBlock adds input to the samples readBlock would read.*/
+	void readBlock(unsigned int offset, int length, float* output);
+	void mixBlock(unsigned int offset, int length, float weight, float* output);
+	void writeBlock(int length, const float* input);
+	void addBlock(unsigned int offset, int length, const float* input);
 	void reset();
 	private:
 	float* buffer = nullptr;
@@ -63,6 +71,8 @@ class DoppleringDelayLine {
 	void setDelayInSamples(int newDelay);
 	void setInterpolationTime(float t);
 	float tick(float sample);
+	//Once the delay stops moving, this works in blocks.  In-place is okay.
+	void processBuffer(int length, float* input, float* output);
 	float computeSample();
 	void advance(float sample);
 	void reset();
@@ -87,6 +97,13 @@ class InterpolatedDelayLine {
 	float tick(float sample);
 	float computeSample();
 	void advance(float sample);
+	/**Nothing written to a line can come out of it for the whole samples of its delay, so that many outputs can be computed before advancing.
+	This is what lets feedback delay networks work in blocks.
+	The limit is one more than the delay in whole samples; computeSampleAhead(i) gives the output i samples from now, for i below the limit.*/
+	int getBlockLimit();
+	float computeSampleAhead(int ahead);
+	void computeBlock(int length, float* output);
+	void advanceBlock(int length, const float* input);
 	void reset();
 	InterpolatedDelayLine* getSlave();
 	void setSlave(InterpolatedDelayLine* s);
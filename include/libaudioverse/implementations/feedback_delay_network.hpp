@@ -4,6 +4,11 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #pragma once
 #include "delayline.hpp"
 #include "../private/kernels.hpp"
+#include "../private/dspmath.hpp"
+#include "../private/memory.hpp"
+#include "../libaudioverse_properties.h"
+#include <algorithm>
+#include <math.h>
 
 namespace libaudioverse_implementation {
 /**A feedback delay network consists of the following:
@@ -19,22 +24,40 @@ This matches the formulation given in Physical Audio Processing for Virtual Musi
 We use a template here because it is necessary to change the type of the delay line.
 Since the advance/read functions would be called n times per sample, virtual functions are unacceptible.
 This has the side effect of moving everything into the header.
+
+The matrix may instead be given a structure from Lav_FDN_MATRIX_STRUCTURES, in which case it is a normalized hadamard or householder matrix followed by a gain per line.
+These are applied as transforms rather than multiplied out: n log n or n operations per sample rather than n^2.
+
+The network can also be run in blocks of up to getBlockLimit() frames, the shortest line's delay, with computeBlock and advanceBlock.
+Blocks are n rows of length samples, one row per line, so that everything in between vectorizes across samples.
+Blocks may be no longer than the maxBlockSize given to the constructor.
 */
 template <class LineType=CrossfadingDelayLine>
 class FeedbackDelayNetwork {
 	public:
-	FeedbackDelayNetwork(int n, float maxDelay, float sr) {
+	FeedbackDelayNetwork(int n, float maxDelay, float sr, int maxBlockSize = 1) {
 		this->n = n;
 		this->sr = sr;
+		max_block_size = maxBlockSize;
 		lines = new LineType*[n];
 		for(int i = 0; i < n; i++) lines[i] = new LineType(maxDelay, sr);
 		matrix = allocArray<float>(n*n);
+		feedback_gains = allocArray<float>(n);
+		scaled_gains = allocArray<float>(n);
+		feedback = allocArray<float>(n*maxBlockSize);
+		scratch = allocArray<float>(maxBlockSize);
+		std::fill(feedback_gains, feedback_gains+n, 1.0f);
+		std::fill(scaled_gains, scaled_gains+n, 1.0f);
 	}
 	
 	~FeedbackDelayNetwork() {
 	for(int i = 0; i < n; i++) delete lines[i];
 		delete[] lines;
 		freeArray(matrix);
+		freeArray(feedback_gains);
+		freeArray(scaled_gains);
+		freeArray(feedback);
+		freeArray(scratch);
 	}
 	
 	void computeFrame(float* outputs) {
@@ -44,10 +67,53 @@ class FeedbackDelayNetwork {
 	}
 	
 	void advance(const float* inputs, const float* lastOutputFrame) {
-		for(int i=0; i < n; i++) {
-			float sample=dotKernel(n, matrix+n*i, lastOutputFrame);
-			sample+=inputs[i];
-			lines[i]->advance(sample);
+		if(matrix_structure == Lav_FDN_MATRIX_STRUCTURE_GENERAL) {
+			for(int i=0; i < n; i++) {
+				float sample=dotKernel(n, matrix+n*i, lastOutputFrame);
+				sample+=inputs[i];
+				lines[i]->advance(sample);
+			}
+			return;
+		}
+		std::copy(lastOutputFrame, lastOutputFrame+n, feedback);
+		if(matrix_structure == Lav_FDN_MATRIX_STRUCTURE_HADAMARD) hadamardTransform(n, 1, feedback);
+		else householderReflection(n, 1, feedback, scratch);
+		multiplicationKernel(n, feedback, scaled_gains, feedback);
+		for(int i = 0; i < n; i++) lines[i]->advance(feedback[i]+inputs[i]);
+	}
+	
+	int getBlockLimit() {
+		int limit = max_block_size;
+		for(int i = 0; i < n; i++) limit = std::min(limit, lines[i]->getBlockLimit());
+		return limit;
+	}
+	
+	void computeBlock(int length, float* outputs) {
+		for(int i = 0; i < n; i++) lines[i]->computeBlock(length, outputs+i*length);
+	}
+	
+	//The block version of advance.  Both arguments are n rows of length samples.
+	void advanceBlock(int length, const float* inputs, const float* lastOutputs) {
+		if(matrix_structure == Lav_FDN_MATRIX_STRUCTURE_GENERAL) {
+			std::fill(feedback, feedback+n*length, 0.0f);
+			for(int i = 0; i < n; i++) {
+				float* row = feedback+i*length;
+				for(int j = 0; j < n; j++) {
+					float weight = matrix[i*n+j];
+					if(weight != 0.0f) multiplicationAdditionKernel(length, weight, (float*)lastOutputs+j*length, row, row);
+				}
+			}
+		}
+		else {
+			std::copy(lastOutputs, lastOutputs+n*length, feedback);
+			if(matrix_structure == Lav_FDN_MATRIX_STRUCTURE_HADAMARD) hadamardTransform(n, length, feedback);
+			else householderReflection(n, length, feedback, scratch);
+			for(int i = 0; i < n; i++) scalarMultiplicationKernel(length, scaled_gains[i], feedback+i*length, feedback+i*length);
+		}
+		for(int i = 0; i < n; i++) {
+			float* row = feedback+i*length;
+			additionKernel(length, row, (float*)inputs+i*length, row);
+			lines[i]->advanceBlock(length, row);
 		}
 	}
 	
@@ -55,6 +121,22 @@ class FeedbackDelayNetwork {
 		std::copy(feedbacks, feedbacks+n*n, matrix);
 	}
 	
+	//One of the Lav_FDN_MATRIX_STRUCTURES.  Hadamard matrices need a power of 2 lines.
+	void setMatrixStructure(int structure) {
+		matrix_structure = structure;
+		updateScaledGains();
+	}
+	
+	int getMatrixStructure() {
+		return matrix_structure;
+	}
+	
+	//Only used with structured matrices; general matrices include their gains.
+	void setFeedbackGains(const float* gains) {
+		std::copy(gains, gains+n, feedback_gains);
+		updateScaledGains();
+	}
+	
 	void setDelays(const float* delays) {
 		for(int i = 0; i < n; i++) setDelay(i, delays[i]);
 	}
@@ -72,7 +154,15 @@ class FeedbackDelayNetwork {
 	}
 	
 	private:
-	int n;
+	//The hadamard transform isn't normalized, so fold that in here.
+	void updateScaledGains() {
+		float scale = matrix_structure == Lav_FDN_MATRIX_STRUCTURE_HADAMARD ? 1.0f/sqrtf((float)n) : 1.0f;
+		scalarMultiplicationKernel(n, scale, feedback_gains, scaled_gains);
+	}
+	
+	int n, max_block_size = 1;
+	int matrix_structure = Lav_FDN_MATRIX_STRUCTURE_GENERAL;
+	float *feedback_gains = nullptr, *scaled_gains = nullptr, *feedback = nullptr, *scratch = nullptr;
 	float sr;
 	LineType **lines = nullptr;
 	float *matrix = nullptr;
@@ -0,0 +1,43 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <kiss_fftr.h>
+
+namespace libaudioverse_implementation {
+
+/**A real-to-complex fft of a fixed size.
+
+This fronts kiss_fftr.  If LIBAUDIOVERSE_USE_SIMD_FFT is defined and the size is a power of two of at least 128, a Stockham radix-2 transform with SSE2 butterflies is used instead.  Every other size falls back to kissfft.
+
+The output format is the same as kiss_fftr in either case: size/2+1 bins, with the imaginary part of the first and last bins zero.
+Like kissfft, inverse is unnormalized: running forward then inverse multiplies by the size.
+*/
+class RealFft {
+	public:
+	//size must be even.
+	RealFft(int size);
+	~RealFft();
+	int getSize();
+	//size/2+1.
+	int getBinCount();
+	//True if this instance isn't using kissfft.
+	bool isUsingSimdBackend();
+	void forward(float* input, kiss_fft_cpx* output);
+	void inverse(kiss_fft_cpx* input, float* output);
+	private:
+	//Runs the half-size complex fft on re/im, returning pointers to the arrays holding the result.
+	void complexFft(bool isInverse, float** outRe, float** outIm);
+	int size = 0, half_size = 0;
+	bool use_simd = false;
+	kiss_fftr_cfg fft = nullptr, ifft = nullptr;
+	float *re = nullptr, *im = nullptr, *work_re = nullptr, *work_im = nullptr;
+	//twiddles for the complex fft, and the twiddles used to split/merge the real transform.
+	float *twiddle_re = nullptr, *twiddle_im = nullptr, *split_re = nullptr, *split_im = nullptr;
+};
+
+//Smallest size >= n that RealFft handles quickly.
+//This may be a power of two a little larger than what kiss_fftr_next_fast_size_real would return, if the SIMD backend is enabled.
+int realFftNextFastSize(int n);
+
+}
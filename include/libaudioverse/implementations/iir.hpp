@@ -2,12 +2,29 @@
 This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
+#include <vector>
 
 namespace libaudioverse_implementation {
 
+/**A second order section: b0, b1, b2, a1, a2, with a0 being 1.*/
+struct IirSection {
+	double b0, b1, b2, a1, a2;
+};
+
+/**Factor a transfer function into a gain and a cascade of second order sections, by finding the roots of the numerator and denominator.
+Poles are paired with their nearest zeros, and sections are ordered from the poles furthest from the unit circle to the closest.
+Returns false if the roots can't be found accurately enough to reproduce the original coefficients, in which case the filter should be run as is.*/
+bool factorIirFilter(int numeratorLength, double* numerator, int denominatorLength, double* denominator, double &gain, std::vector<IirSection> &sections);
+
+/**A direct form filter of any order.
+Histories are rings stored twice over, so that each tick writes two values instead of shifting the whole history.*/
 class IIRFilter {
 	public:
 	IIRFilter(double sr);
+	~IIRFilter();
+	//This owns raw arrays.
+	IIRFilter(const IIRFilter&) = delete;
+	IIRFilter& operator=(const IIRFilter&) = delete;
 	float tick(float sample);
 	void configure(int newNumeratorLength, double* newNumerator, int newDenominatorLength,  double* newDenominator);
 	void setGain(double gain);
@@ -19,6 +36,8 @@ class IIRFilter {
 	private:
 	double *history = nullptr, *recursion_history = nullptr, *numerator = nullptr, *denominator = nullptr;
 	int numerator_length = 0, denominator_length = 0;
+	//Where the newest values in the histories are.
+	int history_position = 0, recursion_history_position = 0;
 	double gain = 1.0;
 	double sr;
 };
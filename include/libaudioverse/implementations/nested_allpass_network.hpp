@@ -10,33 +10,46 @@ class NestedAllpassNetwork;
 
 /**Types of ASST node.*/
 enum class NestedAllpassNetworkASTTypes {
-	IDENTITY, READER, ALLPASS, ONE_POLE, NESTED_ALLPASS, BIQUAD,
+	READER, ALLPASS, ONE_POLE, NESTED_ALLPASS, BIQUAD,
 };
 
-/**Uses type erasure to run filters.
-The actual class is constructed and destructed by the NestedAllpassNetwork directly.*/
+/**What a compiled network runs.
+A nested allpass becomes a begin stage, the stages nested inside it, and an end stage; the begin stage owns the line.*/
+enum class NestedAllpassNetworkStageTypes {
+	READER, ALLPASS, ONE_POLE, BIQUAD, BEGIN_NESTED_ALLPASS, END_NESTED_ALLPASS,
+};
+
+/**One stage of a compiled network, with its coefficients and state inline.
+Only the fields for the stage's type are used.*/
+struct NestedAllpassNetworkStage {
+	NestedAllpassNetworkStageTypes type = NestedAllpassNetworkStageTypes::READER;
+	//Allpasses: the coefficient.  Readers: the multiplier.
+	float coefficient = 1.0f;
+	//Allpass lines live in the network's delay memory.
+	//Read is how far back from the write head the line is read, as for DelayRingbuffer.
+	unsigned int line_start = 0, line_length = 0, line_head = 0, line_read = 0;
+	//End stages: the index of the matching begin stage.
+	int partner = 0;
+	//One-poles, as OnePoleFilter.
+	float pole_b0 = 1.0f, pole_a1 = 0.0f, pole_last = 0.0f;
+	//Biquads, as BiquadFilter.
+	double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0, h1 = 0.0, h2 = 0.0;
+};
+
+/**A description of one filter in the network being built, which compile turns into stages.*/
 class NestedAllpassNetworkASTNode {
 	public:
-	NestedAllpassNetworkASTNode(NestedAllpassNetwork* source, NestedAllpassNetworkASTTypes type, void* filter);
-	//Destructor only deletes our filter, not child nodes.
-	~NestedAllpassNetworkASTNode();
-	float tick(float input);
-	//Ticks us and all our nexts.
-	//Returns the rightmost tick in the row.
-	float tickRow(float input);
-	void reset();
-	NestedAllpassNetwork* source = nullptr;
+	NestedAllpassNetworkASTNode(NestedAllpassNetworkASTTypes type);
 	NestedAllpassNetworkASTTypes type;
-	void* filter = nullptr; //Depends on the type.
+	NestedAllpassNetworkStage stage;
 	//Nested is the one that's nested inside, next is the next one on this level.
 	NestedAllpassNetworkASTNode *nested = nullptr, *next = nullptr;
-	//Used for the reader.
-	float reader_mul = 1.0f;
 };
 
 /**This class builds networks of nested allpasses and lowpasses, most commonly used in Schroeder reverb designs.
 
-To use this class, you call vaerious functions that introduce elements or change the nesting level.  When done, you call compile to produce the network.*/
+To use this class, you call vaerious functions that introduce elements or change the nesting level.  When done, you call compile to produce the network.
+Compiling flattens the tree into a contiguous array of stages which tick runs straight through, so there are no pointers to chase or virtual calls per sample.*/
 class NestedAllpassNetwork {
 	public:
 	NestedAllpassNetwork(float sr);
@@ -66,20 +79,23 @@ class NestedAllpassNetwork {
 	void reset();
 	NestedAllpassNetwork* getSlave();
 	void setSlave(NestedAllpassNetwork* s);
-	
-	//called by readers.
-	void contribute(float amount);
 	private:
 	void hookupAST(NestedAllpassNetworkASTNode* node);
-	float sr, next_output;
+	NestedAllpassNetworkASTNode* makeAllpass(NestedAllpassNetworkASTTypes type, int delay, float coefficient);
+	void flatten(NestedAllpassNetworkASTNode* node, std::vector<NestedAllpassNetworkStage> &into, int depth);
+	float sr;
 	//Used to push and pop nesting levels, etc.
 	std::vector<NestedAllpassNetworkASTNode*> stack;
-	//The one we're currently manipulating and the one at the root of the tree we're preparing.
+	//The one we're currently manipulating and the root of the tree we're preparing.
 	//Note: current goes to nullptr when we ahve just begun a nesting level.
 	//In that case, we have to hook it up via the top of trhe stack.
 	NestedAllpassNetworkASTNode* current = nullptr, *next_start = nullptr;
-	//The first node in our tree.
-	NestedAllpassNetworkASTNode* start = nullptr;
+	//The compiled network.
+	std::vector<NestedAllpassNetworkStage> stages;
+	std::vector<float> delay_memory;
+	//Inputs of the nested allpasses we're inside of while ticking.
+	std::vector<float> nesting_inputs;
+	int max_depth = 0;
 	NestedAllpassNetwork* slave = nullptr;
 };
 
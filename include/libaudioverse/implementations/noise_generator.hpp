@@ -0,0 +1,30 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <stdint.h>
+
+namespace libaudioverse_implementation {
+
+/**Generates normally distributed noise a block at a time.
+
+This runs 4 xoshiro128+ generators side by side, one per SSE lane, and turns their output into normally distributed values with the Box-Muller transform.
+Each step of the generators gives 8 values: 4 from the cosine half of the transform and 4 from the sine half.
+The logarithm, sine, and cosine are polynomial approximations accurate to about single precision.*/
+class NoiseGenerator {
+	public:
+	NoiseGenerator(uint32_t seed);
+	void seed(uint32_t seed);
+	//Fill output with normally distributed values.
+	//Values outside [-limit, limit] are redrawn, so the distribution is truncated rather than clipped.
+	void normal(int length, float* output, float standardDeviation, float limit);
+	private:
+	//8 values into output.
+	void normalGroup(float* output, float standardDeviation);
+	//One value from the first lane, for redrawing.
+	float normalSimple(float standardDeviation);
+	//Index is word, then lane, so that each word of every lane loads as one register.
+	uint32_t state[4][4];
+};
+
+}
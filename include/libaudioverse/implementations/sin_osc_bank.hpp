@@ -0,0 +1,37 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <vector>
+
+namespace libaudioverse_implementation {
+
+/**Many SinOscs, summed into one output.
+
+Each oscillator is a rotating unit vector as in SinOsc, but the vectors are stored as structures of arrays and 2 oscillators are rotated at once in double precision.
+All oscillators share one resync counter, so resyncs happen for the whole bank at the same time.*/
+class SinOscBank {
+	public:
+	SinOscBank(float sr, int oscillators, int resync = 100);
+	int getOscillatorCount();
+	void setFrequency(int which, double frequency);
+	void setAmplitude(int which, double amplitude);
+	//As SinOsc, measured in periods.
+	void setPhase(int which, double phase);
+	double getPhase(int which);
+	//Every oscillator goes back to phase 0.
+	void reset();
+	//Writes the sum of every oscillator multiplied by its amplitude.
+	void process(int blockSize, float* output);
+	private:
+	//Rotate every oscillator count times, adding to sums which holds 2 doubles per sample.
+	void rotate(int count, double* sums);
+	void doResync();
+	float sr;
+	int oscillators, resync, resync_counter;
+	//s=sin, c=cos, as SinOsc.
+	std::vector<double> sx, cx, sd, cd, amplitudes, phases, phase_increments;
+	std::vector<double> sums;
+};
+
+}
@@ -0,0 +1,52 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <vector>
+#include <memory>
+
+namespace libaudioverse_implementation {
+
+enum class BandlimitedWaveforms {
+	SQUARE, TRIANGLE, SAW, BLIT,
+};
+
+/**One period of a waveform, summed from its harmonics, with one table per octave.
+
+The first table has bandlimited_wavetable_length/2 harmonics, and each table after it has half as many as the one before, down to just the fundamental.
+Each table is used for the octave of frequencies at which its highest harmonic is just below nyquist, so nothing aliases.
+Every table has one extra sample equal to the first, so interpolation never has to wrap.
+
+These are immutable once built and are normally shared between all oscillators through getBandlimitedWavetable.*/
+class BandlimitedWavetable {
+	public:
+	BandlimitedWavetable(BandlimitedWaveforms waveform, int sr);
+	//The table to use for the specified frequency.
+	const float* getTable(double frequency) const;
+	int getTableCount() const;
+	private:
+	int sr;
+	std::vector<std::vector<float>> tables;
+};
+
+const int bandlimited_wavetable_length = 2048;
+
+/**Plays a BandlimitedWavetable with linear interpolation, 4 samples at a time.
+Changing the frequency changes the table, but tables are only switched between calls to process.*/
+class WavetableOscillator {
+	public:
+	WavetableOscillator(std::shared_ptr<BandlimitedWavetable> wavetable, float sr);
+	void setFrequency(double frequency);
+	//Measured in periods.
+	void setPhase(double phase);
+	double getPhase();
+	void reset();
+	void process(int length, float* output);
+	private:
+	std::shared_ptr<BandlimitedWavetable> wavetable;
+	const float* table;
+	float sr;
+	double phase = 0.0, phase_increment = 0.0;
+};
+
+}
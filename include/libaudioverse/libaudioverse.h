@@ -128,6 +128,9 @@ enum Lav_OBJECT_TYPES {
 	Lav_OBJTYPE_BLIT_NODE,
 	Lav_OBJTYPE_DC_BLOCKER_NODE,
 	Lav_OBJTYPE_LEAKY_INTEGRATOR_NODE,
+	Lav_OBJTYPE_MATRIX_CONVOLVER_NODE,
+	Lav_OBJTYPE_FILE_STREAMER_NODE,
+	Lav_OBJTYPE_OSCILLATOR_BANK_NODE,
 };
 
 /**Node states.*/
@@ -236,6 +239,8 @@ To clear, use null as the callback.*/
 typedef void (*LavBlockCallback)(LavHandle handle, double time, void* userdata);
 Lav_PUBLIC_FUNCTION LavError Lav_simulationSetBlockCallback(LavHandle simulationHandle, LavBlockCallback callback, void* userdata);
 Lav_PUBLIC_FUNCTION LavError Lav_simulationWriteFile(LavHandle simulationHandle, const char* path, int channels, double duration, int mayApplyMixingMatrix);
+typedef void (*LavWriteFileProgressCallback)(LavHandle simulationHandle, double rendered, double total, double framesPerSecond, void* userdata);
+Lav_PUBLIC_FUNCTION LavError Lav_simulationWriteFileWithProgress(LavHandle simulationHandle, const char* path, int channels, double duration, int mayApplyMixingMatrix, LavWriteFileProgressCallback callback, void* userdata);
 
 Lav_PUBLIC_FUNCTION LavError Lav_simulationSetThreads(LavHandle simulationHandle, int threads);
 Lav_PUBLIC_FUNCTION LavError Lav_simulationGetThreads(LavHandle simulationHandle, int* destination);
@@ -245,10 +250,19 @@ Buffers are chunks of audio data from any source.  A variety of nodes to work wi
 Lav_PUBLIC_FUNCTION LavError Lav_createBuffer(LavHandle simulationHandle, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferGetSimulation(LavHandle bufferHandle, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFile(LavHandle bufferHandle, const char* path);
+/**Called when an asynchronous load finishes.
+result is Lav_ERROR_NONE on success, and otherwise the error that stopped the load.*/
+typedef void (*LavAsyncLoadCallback)(LavHandle handle, LavError result, void* userdata);
+Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFileAsync(LavHandle bufferHandle, const char* path, LavAsyncLoadCallback callback, void* userdata);
+Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFilesBatch(int count, LavHandle* bufferHandles, const char** paths, LavAsyncLoadCallback callback, void* userdata);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromArray(LavHandle bufferHandle, int sr, int channels, int frames, float* data);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferNormalize(LavHandle bufferHandle);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferGetDuration(LavHandle bufferHandle, float* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferGetLengthInSamples(LavHandle bufferHandle, int* destination);
+Lav_PUBLIC_FUNCTION LavError Lav_bufferSetStorageFormat(LavHandle bufferHandle, int format);
+Lav_PUBLIC_FUNCTION LavError Lav_bufferGetStorageFormat(LavHandle bufferHandle, int* destination);
+Lav_PUBLIC_FUNCTION LavError Lav_setSampleCacheBudget(int megabytes);
+Lav_PUBLIC_FUNCTION LavError Lav_getSampleCacheBudget(int* destination);
 
 Lav_PUBLIC_FUNCTION LavError Lav_nodeGetSimulation(LavHandle nodeHandle, LavHandle* destination);
 /**Connect two nodes.*/
@@ -340,6 +354,7 @@ Lav_PUBLIC_FUNCTION LavError Lav_createAdditiveSquareNode(LavHandle simulationHa
 Lav_PUBLIC_FUNCTION LavError Lav_createAdditiveTriangleNode(LavHandle simulationHandle, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_createAdditiveSawNode(LavHandle simulationHandle, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_createNoiseNode(LavHandle simulationHandle, LavHandle* destination);
+Lav_PUBLIC_FUNCTION LavError Lav_createOscillatorBankNode(LavHandle simulationHandle, int oscillators, LavHandle* destination);
 
 Lav_PUBLIC_FUNCTION LavError Lav_createHrtfNode(LavHandle simulationHandle, const char* hrtfPath, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_createHardLimiterNode(LavHandle simulationHandle, int channels, LavHandle *destination);
@@ -370,6 +385,7 @@ Lav_PUBLIC_FUNCTION LavError Lav_pullNodeSetAudioCallback(LavHandle nodeHandle,
 typedef void (*LavGraphListenerNodeListeningCallback)(LavHandle nodeHandle, unsigned int frames, unsigned int channels, float* buffer, void* userdata);
 Lav_PUBLIC_FUNCTION LavError Lav_createGraphListenerNode(LavHandle simulationHandle, unsigned int channels, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_graphListenerNodeSetListeningCallback(LavHandle nodeHandle, LavGraphListenerNodeListeningCallback callback, void* userdata);
+Lav_PUBLIC_FUNCTION LavError Lav_graphListenerNodeReadTap(LavHandle nodeHandle, unsigned int frames, float* destination, unsigned int* framesRead);
 
 //custom nodes.
 //the callback does the processing if set, otherwise outputs are zeroed.
@@ -399,6 +415,9 @@ Lav_PUBLIC_FUNCTION LavError Lav_createChannelMergerNode(LavHandle simulationHan
 Lav_PUBLIC_FUNCTION LavError Lav_createBufferNode(LavHandle simulationHandle, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferNodeSetEndCallback(LavHandle nodeHandle, LavParameterlessCallback callback, void* userdata);
 
+Lav_PUBLIC_FUNCTION LavError Lav_createFileStreamerNode(LavHandle simulationHandle, const char* path, LavHandle* destination);
+Lav_PUBLIC_FUNCTION LavError Lav_fileStreamerNodeSetEndCallback(LavHandle nodeHandle, LavParameterlessCallback callback, void* userdata);
+
 Lav_PUBLIC_FUNCTION LavError Lav_createBufferTimelineNode(LavHandle simulationHandle, int channels, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_bufferTimelineNodeScheduleBuffer(LavHandle nodeHandle, LavHandle bufferHandle, double time, float pitchBend);
 
@@ -411,6 +430,11 @@ Lav_PUBLIC_FUNCTION LavError Lav_createConvolverNode(LavHandle simulationHandle,
 Lav_PUBLIC_FUNCTION LavError Lav_createFftConvolverNode(LavHandle simulationHandle, int channels, LavHandle* destination);
 Lav_PUBLIC_FUNCTION LavError Lav_fftConvolverNodeSetResponse(LavHandle nodeHandle, int channel, int length, float* response);
 Lav_PUBLIC_FUNCTION LavError Lav_fftConvolverNodeSetResponseFromFile(LavHandle nodeHandle, const char* path, int fileChannel, int convolverChannel);
+Lav_PUBLIC_FUNCTION LavError Lav_fftConvolverNodeSetResponseFromFileAsync(LavHandle nodeHandle, const char* path, int fileChannel, int convolverChannel, LavAsyncLoadCallback callback, void* userdata);
+
+Lav_PUBLIC_FUNCTION LavError Lav_createMatrixConvolverNode(LavHandle simulationHandle, int inputChannels, int outputChannels, LavHandle* destination);
+Lav_PUBLIC_FUNCTION LavError Lav_matrixConvolverNodeSetResponse(LavHandle nodeHandle, int inputChannel, int outputChannel, int length, float* response);
+Lav_PUBLIC_FUNCTION LavError Lav_matrixConvolverNodeSetResponseFromFile(LavHandle nodeHandle, const char* path, int fileChannel, int inputChannel, int outputChannel);
 
 Lav_PUBLIC_FUNCTION LavError Lav_createThreeBandEqNode(LavHandle simulationHandle, int channels, LavHandle* destination);
 
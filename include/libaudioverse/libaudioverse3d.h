@@ -43,6 +43,7 @@ enum Lav_SOURCE_PROPERTIES {
 	Lav_SOURCE_MIN_REVERB_LEVEL = -10,
 	Lav_SOURCE_MAX_REVERB_LEVEL = -11,
 	Lav_SOURCE_OCCLUSION = -12,
+	Lav_SOURCE_OCCLUSION_PRECISION = -13,
 };
 
 enum Lav_DISTANCE_MODELS {
@@ -37,6 +37,12 @@ enum Lav_OSCILLATOR_PROPERTIES {
 	Lav_OSCILLATOR_FREQUENCY_MULTIPLIER = -202,
 };
 
+enum Lav_OSCILLATOR_BANK_PROPERTIES {
+	Lav_OSCILLATOR_BANK_FREQUENCIES = -1,
+	Lav_OSCILLATOR_BANK_AMPLITUDES = -2,
+	Lav_OSCILLATOR_BANK_PHASES = -3,
+};
+
 enum lav_SQUARE_PROPERTIES {
 	Lav_SQUARE_HARMONICS = -1,
 	Lav_SQUARE_DUTY_CYCLE = -2,
@@ -103,6 +109,7 @@ enum Lav_DELAY_PROPERTIES {
 
 enum Lav_PUSH_NODE_PROPERTIES {
 	Lav_PUSH_THRESHOLD = -1,
+	Lav_PUSH_DROPPED_FRAMES = -2,
 };
 
 //biquad objects.
@@ -112,6 +119,12 @@ enum Lav_BIQUAD_PROPERTIES {
 	Lav_BIQUAD_Q = -2,
 	Lav_BIQUAD_FREQUENCY = -3,
 	Lav_BIQUAD_DBGAIN = -4,
+	Lav_BIQUAD_PRECISION = -5,
+};
+
+enum Lav_BIQUAD_PRECISIONS {
+	Lav_BIQUAD_PRECISION_DOUBLE = 0,
+	Lav_BIQUAD_PRECISION_FLOAT = 1,
 };
 
 enum Lav_BIQUAD_TYPES {
@@ -126,6 +139,13 @@ enum Lav_BIQUAD_TYPES {
 	Lav_BIQUAD_TYPE_IDENTITY = 8,
 };
 
+enum Lav_BUFFER_STORAGE_FORMATS {
+	Lav_BUFFER_STORAGE_FORMAT_FLOAT32 = 0,
+	Lav_BUFFER_STORAGE_FORMAT_INT16 = 1,
+	Lav_BUFFER_STORAGE_FORMAT_FLOAT16 = 2,
+	Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM = 3,
+};
+
 //this is for feedback delay networks. We shorten because otherwise it would be insane to actually use these.
 enum Lav_FEEDBACK_DELAY_NETWORK_PROPERTIES {
 	Lav_FDN_MAX_DELAY = -1,
@@ -134,6 +154,8 @@ enum Lav_FEEDBACK_DELAY_NETWORK_PROPERTIES {
 	Lav_FDN_MATRIX = -4,
 	Lav_FDN_FILTER_TYPES = -5,
 	Lav_FDN_FILTER_FREQUENCIES = -6,
+	Lav_FDN_MATRIX_STRUCTURE = -7,
+	Lav_FDN_FEEDBACK_GAINS = -8,
 };
 
 enum Lav_FDN_FILTER_TYPES {
@@ -142,12 +164,30 @@ enum Lav_FDN_FILTER_TYPES {
 	Lav_FDN_FILTER_TYPE_HIGHPASS = 2,
 };
 
+//Hadamard is last so that the range can exclude it when the line count isn't a power of 2.
+enum Lav_FDN_MATRIX_STRUCTURES {
+	Lav_FDN_MATRIX_STRUCTURE_GENERAL = 0,
+	Lav_FDN_MATRIX_STRUCTURE_HOUSEHOLDER = 1,
+	Lav_FDN_MATRIX_STRUCTURE_HADAMARD = 2,
+};
+
 enum Lav_BUFFER_PROPERTIES {
 	Lav_BUFFER_BUFFER = -1,
 	Lav_BUFFER_POSITION = -2,
 	Lav_BUFFER_RATE = -3,
 	Lav_BUFFER_LOOPING = -4,
 	Lav_BUFFER_ENDED_COUNT = -5,
+	Lav_BUFFER_INTERPOLATION = -6,
+};
+
+enum Lav_BUFFER_TIMELINE_PROPERTIES {
+	Lav_BUFFER_TIMELINE_INTERPOLATION = -1,
+};
+
+enum Lav_INTERPOLATION_TYPES {
+	Lav_INTERPOLATION_TYPE_LINEAR = 0,
+	Lav_INTERPOLATION_TYPE_CUBIC = 1,
+	Lav_INTERPOLATION_TYPE_SINC = 2,
 };
 
 enum Lav_CONVOLVER_PROPERTIES {
@@ -213,6 +253,22 @@ enum Lav_LEAKY_INTEGRATOR_PROPERTIES {
 	Lav_LEAKY_INTEGRATOR_LEAKYNESS = -1,
 };
 
+enum Lav_RECORDER_PROPERTIES {
+	Lav_RECORDER_BUFFER_DURATION = -1,
+	Lav_RECORDER_DROPPED_BLOCKS = -2,
+};
+
+enum Lav_FILE_STREAMER_PROPERTIES {
+	Lav_FILE_STREAMER_POSITION = -1,
+	Lav_FILE_STREAMER_LOOPING = -2,
+	Lav_FILE_STREAMER_ENDED_COUNT = -3,
+};
+
+enum Lav_GRAPH_LISTENER_PROPERTIES {
+	Lav_GRAPH_LISTENER_TAP_ENABLED = -1,
+	Lav_GRAPH_LISTENER_TAP_OVERRUNS = -2,
+};
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -3,8 +3,9 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
 #include "../private/node.hpp"
-#include "../implementations/iir.hpp"
-#include <random>
+#include "../implementations/biquad_bank.hpp"
+#include "../implementations/noise_generator.hpp"
+#include <vector>
 #include <memory>
 
 namespace libaudioverse_implementation {
@@ -16,10 +17,12 @@ class NoiseNode: public Node {
 	void white();
 	void pink();
 	void brown();
-	std::minstd_rand random_number_generator;
-	std::normal_distribution<float> normal_distribution;
-	IIRFilter pinkifier; //filter to turn white noise into pink noise.
-	IIRFilter brownifier; //and likewise for brown.
+	void configureColoring(int numeratorLength, double* numerator, int denominatorLength, double* denominator, double &gain, std::vector<BiquadBank> &sections);
+	void color(double gain, std::vector<BiquadBank> &sections);
+	NoiseGenerator generator;
+	//Filters to turn white noise into pink and brown noise.
+	std::vector<BiquadBank> pink_sections, brown_sections;
+	double pink_gain = 1.0, brown_gain = 1.0;
 	float pink_max = 0.0f, brown_max = 0.0f; //used for normalizing noise.
 };
 
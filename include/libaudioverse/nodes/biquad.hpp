@@ -3,22 +3,33 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
 #include "../private/node.hpp"
-#include "../implementations/biquad.hpp"
-#include "../private/multichannel_filter_bank.hpp"
+#include "../implementations/biquad_bank.hpp"
 #include <memory>
+#include <vector>
 
 namespace libaudioverse_implementation {
 
 class Simulation;
 
+/**Mono biquads in the same bin of the plan are processed as one batch, with a lane per node.
+This is mostly for sources, which each have a mono biquad for occlusion.*/
 class BiquadNode: public Node {
 	public:
 	BiquadNode(std::shared_ptr<Simulation> sim, unsigned int channels);
 	void process();
 	void reconfigure();
 	void reset() override;
+	int getBatchKey() override;
+	void executeBatch(std::shared_ptr<Job>* jobs, int count) override;
 	private:
-	MultichannelFilterBank<BiquadFilter> bank;
+	//Handles property changes, for both process and executeBatch.
+	void updateFilter();
+	//One lane per channel.
+	BiquadBank bank;
+	//Used when this node leads a batch.
+	BiquadBank batch_bank;
+	std::vector<BiquadNode*> batch_nodes;
+	std::vector<float*> batch_inputs, batch_outputs;
 	int prev_type;
 };
 
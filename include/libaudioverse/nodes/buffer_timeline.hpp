@@ -5,6 +5,8 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include "../private/node.hpp"
 #include <map>
 #include <memory>
+#include <vector>
+#include <stdint.h>
 
 namespace libaudioverse_implementation {
 
@@ -12,6 +14,16 @@ class Simulation;
 class Buffer;
 class BufferPlayer;
 
+struct ScheduledBufferPlayer {
+	BufferPlayer* player;
+	//The block it starts in, counted from the node's creation, and the frame within that block.
+	int64_t block;
+	int offset;
+};
+
+/**Schedules are kept in a timing wheel with a slot per block, so each block only looks at what starts in it.
+Anything further out than one turn of the wheel waits in an overflow map until it comes into range.
+Players come from a pool and are returned to it when they finish, and mix straight into the outputs.*/
 class BufferTimelineNode: public Node {
 	public:
 	BufferTimelineNode(std::shared_ptr<Simulation> simulation, int channels);
@@ -20,11 +32,20 @@ class BufferTimelineNode: public Node {
 	void scheduleBuffer(double time, float delta, std::shared_ptr<Buffer> buffer);
 	void reset() override;
 	private:
-	std::multimap<double, BufferPlayer*> scheduled_buffers;
-	std::vector<float*> workspace;
-	double time = 0.0;
+	BufferPlayer* getPlayer();
+	void returnPlayer(BufferPlayer* player);
+	void addToWheel(ScheduledBufferPlayer scheduled);
+	std::vector<std::vector<ScheduledBufferPlayer>> wheel;
+	//What every slot has reserved.
+	unsigned int wheel_slot_capacity = 0;
+	std::multimap<int64_t, ScheduledBufferPlayer> overflow;
+	std::vector<BufferPlayer*> active_players, free_players;
+	//Every player this node has ever made, for cleanup.
+	std::vector<BufferPlayer*> all_players;
+	//The block about to be processed.
+	int64_t block_counter = 0;
 	int output_channels = 0;
 };
 
 std::shared_ptr<Node> createBufferTimelineNode(std::shared_ptr<Simulation> simulation, int channels);
-}
\ No newline at end of file
+}
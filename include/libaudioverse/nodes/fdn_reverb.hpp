@@ -28,6 +28,10 @@ class FdnReverbNode: public Node {
 	//Modulation state.
 	bool needs_modulation = false;
 	float modulation_depth = 0.0f; //equal to the property times the modulation duration from above.
+	//The longest chunk that is safe with the lines at their shortest modulated delay.
+	int modulated_block_limit = 1;
+	//8 rows of up to block_size samples each, one per line.
+	float *line_values = nullptr, *feedbacks = nullptr;
 };
 
 std::shared_ptr<Node> createFdnReverbNode(std::shared_ptr<Simulation> simulation);
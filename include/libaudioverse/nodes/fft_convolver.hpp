@@ -4,6 +4,8 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #pragma once
 #include "../private/node.hpp"
 #include <memory>
+#include <string>
+#include <functional>
 
 namespace libaudioverse_implementation {
 
@@ -17,6 +19,8 @@ class FftConvolverNode: public Node {
 	virtual void process();
 	void setResponse(int channel, int length, float* response);
 	void setResponseFromFile(std::string path, int fileChannel, int convolverChannel);
+	//Decodes and transforms on the loader pool, then swaps the response in between blocks.
+	void setResponseFromFileAsync(std::string path, int fileChannel, int convolverChannel, std::function<void(LavError)> callback);
 	int channels;
 	FftConvolver **convolvers;
 };
@@ -0,0 +1,64 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include "../libaudioverse.h"
+#include "../private/node.hpp"
+#include "../private/callback.hpp"
+#include "../private/file.hpp"
+#include "../private/spsc_ring.hpp"
+#include <speex_resampler_cpp.hpp>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <thread>
+
+namespace libaudioverse_implementation {
+
+class Simulation;
+
+//One block of decoded, resampled, interleaved audio.
+struct StreamedBlock {
+	float* data = nullptr;
+	//The seek this block belongs to.  Blocks from before the most recent seek are discarded.
+	int generation = 0;
+	//In seconds, at the start of the block.
+	double position = 0.0;
+	//How many times the file ended during this block.
+	int ended = 0;
+};
+
+/**Plays a file from disk without loading all of it.
+
+A background thread decodes and resamples a little way ahead of playback into a pool of blocks.
+Filled blocks go to the audio thread and empty ones come back through two lock-free rings, so the audio thread never waits on disk.*/
+class FileStreamerNode: public Node {
+	public:
+	FileStreamerNode(std::shared_ptr<Simulation> simulation, std::string path);
+	~FileStreamerNode();
+	virtual void process();
+	std::shared_ptr<Callback<void()>> end_callback;
+	private:
+	void readAheadThreadFunction();
+	//Read the next chunk of the file into the resampler, handling looping.  Returns false at the end of a non-looping file.
+	bool feedResampler(int &ended);
+	void seekReader(double position);
+	FileReader reader;
+	std::shared_ptr<speex_resampler_cpp::Resampler> resampler = nullptr;
+	int channels = 0, chunk_frames = 0;
+	unsigned int file_frames = 0;
+	double file_sr = 0.0, duration = 0.0;
+	float* chunk = nullptr;
+	std::vector<StreamedBlock> blocks;
+	SpscRing<StreamedBlock*> filled, empty;
+	//Written by the audio thread, read by the read-ahead thread.
+	std::atomic<int> seek_generation{0};
+	std::atomic<double> seek_position{0.0};
+	std::atomic<bool> looping{false}, should_stop{false};
+	//Audio thread only.
+	int current_generation = 0;
+	std::thread read_ahead_thread;
+};
+
+std::shared_ptr<Node> createFileStreamerNode(std::shared_ptr<Simulation> simulation, std::string path);
+}
@@ -4,17 +4,25 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #pragma once
 #include "../libaudioverse.h"
 #include "../private/node.hpp"
+#include "../private/spsc_ring.hpp"
 #include <memory>
 
 namespace libaudioverse_implementation {
 
 class Simulation;
 
+/**Audio can be observed in two ways.
+The callback is called synchronously from process.
+The tap copies each block into a lock-free ring instead, which any one thread can drain with readTap without ever holding up the audio thread.*/
 class GraphListenerNode: public Node {
 	public:
 	GraphListenerNode(std::shared_ptr<Simulation> sim, unsigned int channels);
 	~GraphListenerNode();
 	void process();
+	//Returns frames read.  Only one thread may call this at a time.
+	unsigned int readTap(unsigned int frames, float* destination);
+	//Interleaved, holding about a second of audio.
+	SpscRing<float> tap;
 	LavGraphListenerNodeListeningCallback callback = nullptr;
 	float* outgoing_buffer = nullptr;
 	void* callback_userdata = nullptr;
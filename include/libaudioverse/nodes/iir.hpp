@@ -3,13 +3,17 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
 #include "../private/node.hpp"
+#include "../implementations/biquad_bank.hpp"
+#include "../implementations/iir.hpp"
 #include <memory>
+#include <vector>
 
 namespace libaudioverse_implementation {
 
 class Simulation;
-class IIRFilter;
 
+/**Filters which can be factored are run as a cascade of second-order sections, one bank per section with a lane per channel.
+Anything else falls back to the direct form filters.*/
 class IirNode: public Node {
 	public:
 	IirNode(std::shared_ptr<Simulation> simulation, int channels);
@@ -18,6 +22,11 @@ class IirNode: public Node {
 	void setCoefficients(int numeratorLength, double* numerator, int denominatorLength, double* denominator, int shouldClearHistory);
 	IIRFilter** filters;
 	int channels;
+	bool use_sections = false;
+	double section_gain = 1.0;
+	std::vector<BiquadBank> sections;
+	//The coefficients each section was last configured with, used to match sections up when the coefficients change.
+	std::vector<IirSection> section_poles;
 };
 
 std::shared_ptr<Node> createIirNode(std::shared_ptr<Simulation> simulation, int channels);
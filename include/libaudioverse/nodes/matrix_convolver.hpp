@@ -0,0 +1,27 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include "../private/node.hpp"
+#include <memory>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+class Simulation;
+class FftMatrixConvolver;
+
+class MatrixConvolverNode: public Node {
+	public:
+	MatrixConvolverNode(std::shared_ptr<Simulation> simulation, int inputChannels, int outputChannels);
+	~MatrixConvolverNode();
+	virtual void process();
+	virtual void reset() override;
+	void setResponse(int inputChannel, int outputChannel, int length, float* response);
+	void setResponseFromFile(std::string path, int fileChannel, int inputChannel, int outputChannel);
+	int input_channels, output_channels;
+	FftMatrixConvolver *convolver;
+};
+
+std::shared_ptr<Node> createMatrixConvolverNode(std::shared_ptr<Simulation> simulation, int inputChannels, int outputChannels);
+}
@@ -5,13 +5,17 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include "../libaudioverse.h"
 #include "../private/node.hpp"
 #include "../private/callback.hpp"
+#include "../private/spsc_ring.hpp"
 #include <speex_resampler_cpp.hpp>
 #include <memory>
+#include <atomic>
 
 namespace libaudioverse_implementation {
 
 class Simulation;
 
+/**Feeding goes through a lock-free ring, so feed never takes the simulation's lock or waits on the audio thread.
+Only one thread may feed at a time.  Everything else, resampling included, happens in process.*/
 class PushNode: public Node {
 	public:
 	PushNode(std::shared_ptr<Simulation> sim, unsigned int inputSr, unsigned int channels);
@@ -22,7 +26,11 @@ class PushNode: public Node {
 	unsigned int input_sr = 0;
 	std::shared_ptr<speex_resampler_cpp::Resampler> resampler = nullptr;
 	float* workspace = nullptr;
-	//the push_* variables are for the public api to feed us.
+	//Interleaved samples at the input rate, from feed to process.
+	SpscRing<float> fed;
+	//Frames that didn't fit in fed.
+	std::atomic<unsigned int> dropped_frames{0};
+	//Process gathers fed audio here until there's enough to give to the resampler.
 	float* push_buffer = nullptr;
 	unsigned int push_channels = 0;
 	unsigned int push_frames = 1024;
@@ -4,9 +4,7 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #pragma once
 #include "../private/node.hpp"
 #include "../private/file.hpp"
-#include <powercores/threadsafe_queue.hpp>
 #include <thread>
-#include <mutex>
 #include <atomic>
 #include <memory>
 
@@ -14,25 +12,30 @@ namespace libaudioverse_implementation {
 
 class Simulation;
 
+/**The audio thread interleaves blocks into a preallocated ring, which the recording thread drains in as few writes as it can.
+
+The ring is one allocation of ring_blocks blocks, allocated when recording starts.
+The audio thread only advances blocks_written and the recording thread only advances blocks_read, so neither ever waits on the other.
+If the ring is full, the block is dropped and counted rather than allocating.*/
 class RecorderNode: public Node {
 	public:
 	RecorderNode(std::shared_ptr<Simulation> simulation, int channels);
 	~RecorderNode();
 	void recordingThreadFunction();
 	virtual void process() override;
-	virtual void doMaintenance() override;
 	void startRecording(std::string path);
 	void stopRecording();
 	std::thread recording_thread;
-	powercores::ThreadsafeQueue<float*> available_buffers;
-	powercores::ThreadsafeQueue<float*> unwritten_buffers;
-	int buffer_size = 0;
-	int buffer_freeing_threshold =20; //If we ever get this far ahead, we free some buffers.
-	std::atomic_flag should_keep_recording;
+	float* ring = nullptr;
+	//In blocks.
+	unsigned int ring_blocks = 0;
+	//These only ever increase, and wrap.
+	std::atomic<unsigned int> blocks_written{0}, blocks_read{0};
+	std::atomic<bool> should_keep_recording{false};
 	FileWriter recording_to;
 	int channels = 0;
 	bool recording = false;
 };
 
 std::shared_ptr<Node> createRecorderNode(std::shared_ptr<Simulation> simulation, int channels);
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
 #include "memory.hpp"
+#include "../libaudioverse_properties.h"
 #include <memory>
 #include <atomic>
 
@@ -10,6 +11,33 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 namespace libaudioverse_implementation {
 class Simulation;
 
+/**The samples of a buffer.
+
+This never changes after construction, so any number of buffers and the sample cache can share one.
+Buffers that want to change their samples build a new one instead.*/
+class BufferStorage {
+	public:
+	//Takes ownership of data, which is uninterleaved and allocated with new[], and encodes it in format.
+	BufferStorage(int channels, int frames, int format, float* data);
+	~BufferStorage();
+	int getChannels();
+	int getFrames();
+	int getFormat();
+	//Bytes used to hold the samples.
+	long long getMemoryUsage();
+	//See the comments on Buffer.
+	void readFrames(int frame, int channel, int count, float* destination);
+	float* getPointer(int frame, int channel);
+	//Decode everything into a new[] array.
+	float* decodeAll();
+	private:
+	int channels = 0, frames = 0, format = Lav_BUFFER_STORAGE_FORMAT_FLOAT32;
+	//data holds float32 samples; everything else lives in encoded_data, encoded_channel_bytes per channel.
+	float* data = nullptr;
+	unsigned char* encoded_data = nullptr;
+	long long encoded_channel_bytes = 0;
+};
+
 class Buffer: public ExternalObject {
 	public:
 	Buffer(std::shared_ptr<Simulation> simulation);
@@ -20,11 +48,25 @@ class Buffer: public ExternalObject {
 	int getChannels();
 	//This can be used outside the lock; the only thing it does is read simulation's sr value which can never change by definition.
 	void loadFromArray(int sr, int channels, int frames, float* inputData);
-	//The following two functions do not check if the requested frame is past the end for efficiency.
+	//Replace the contents with already-resampled, uninterleaved data, which must have been allocated with new[].
+	//Takes ownership of data, encoding it in the storage format.  Call with the lock held.
+	void replaceData(int channels, int frames, float* data);
+	//Share storage with something else.  Call with the lock held.
+	void setStorage(std::shared_ptr<BufferStorage> storage);
+	std::shared_ptr<BufferStorage> getStorage();
+	//One of the Lav_BUFFER_STORAGE_FORMATS.  Changing it re-encodes the current contents.
+	int getStorageFormat();
+	void setStorageFormat(int format);
+	//Bytes used to hold the samples, including any shared with other buffers.
+	long long getMemoryUsage();
+	//The following functions do not check if the requested frame is past the end for efficiency.
 	//It is possible the compiler would optimize this, but running  in debug mode is already really painful and the trade-off here is worth it.
-	//a single sample without mixing:
+	//a single sample without mixing.  Slow for compressed formats; prefer readFrames.
 	float getSample(int frame, int channel);
+	//Decode count frames of one channel starting at frame into destination.  Works for every storage format.
+	void readFrames(int frame, int channel, int count, float* destination);
 	//Get a pointer to part of the buffer, so that we can memcpy and stuff.
+	//Returns nullptr unless the storage format is Lav_BUFFER_STORAGE_FORMAT_FLOAT32; everything else must use readFrames.
 	float* getPointer(int frame, int channel);
 	//meet lockable concept:
 	void lock();
@@ -33,21 +75,28 @@ class Buffer: public ExternalObject {
 	//Normalize the buffer: divide by the sample furthest from zero.
 	//This can't be undone.
 	void normalize();
-	
+
 	//Lock and unlock the user's ability to change the buffer's contents.
 	//These three functions are technically threadsafe, as they all use an atomic variable.
 	void incrementUseCount();
 	void decrementUseCount();
 	void throwIfInUse();
+	bool isInUse();
 	private:
 	int channels = 0;
 	int frames = 0;
 	int sr = 0;
-	float* data = nullptr;
+	int storage_format = Lav_BUFFER_STORAGE_FORMAT_FLOAT32;
+	//Null while empty.  Never modified in place, since other buffers may be using it.
+	std::shared_ptr<BufferStorage> storage = nullptr;
 	std::shared_ptr<Simulation> simulation;
 	std::atomic<int> use_count{0};
 };
 
 std::shared_ptr<Buffer> createBuffer(std::shared_ptr<Simulation>simulation);
 
-}
\ No newline at end of file
+/**Resample interleaved data to outputSr and uninterleave it, which is everything loading a buffer needs besides the final swap.
+Touches no shared state, so it's safe anywhere.  The result is allocated with new[].*/
+float* prepareBufferData(int inputSr, int outputSr, int channels, int frames, float* inputData, int* framesOut);
+
+}
@@ -32,4 +32,13 @@ void hadamard(int n, float* buffer, bool shouldNormalize=true);
 //Fill a buffer with a matrix representing a reflectiona bout a plane whose normal is (1, 1, 1, 1...)
 //This is also known as a householder matrix.
 void householder(int n, float* buffer, bool shouldNormalize =true);
+
+/**Multiply by these matrices without building them.
+Buffer holds n rows of length floats each, one after the other, and every column is transformed in place.
+With length 1, this is just a vector.
+
+The hadamard transform is unnormalized, and costs n log n; n must be a power of 2.
+The householder reflection is already orthogonal, and costs n.  It needs scratch space of length floats.*/
+void hadamardTransform(int n, int length, float* buffer);
+void householderReflection(int n, int length, float* buffer, float* scratch);
 }
\ No newline at end of file
@@ -22,6 +22,8 @@ class FileReader: std::enable_shared_from_this<FileReader>  {
 	unsigned int getSampleCount();
 	unsigned int readAll(float* buffer);
 	unsigned int read(unsigned int frames, float* buffer);
+	//Move the read position to the specified frame.
+	void seek(unsigned int frame);
 	protected:
 	SNDFILE* handle = nullptr;
 	SF_INFO info;
@@ -7,6 +7,7 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <vector>
 #include <map>
 #include <memory>
+#include <tuple>
 
 /**See planner.hpp.
 This file is for the Job base class, and reduces dependencies on powercores.*/
@@ -27,11 +28,19 @@ class  Job: public ExternalObject {
 	virtual ~Job() {}
 	virtual void execute() {}
 	virtual bool canCull() {return false;}
+	//Jobs in the same bin which return the same nonzero key are run together, through executeBatch on the first of them.
+	//Keys are checked every time the plan runs, so they may change.
+	virtual int getBatchKey() {return 0;}
+	//Jobs is every job in the batch, including this one.
+	virtual void executeBatch(std::shared_ptr<Job>* jobs, int count) {
+		for(int i = 0; i < count; i++) jobs[i]->execute();
+	}
 	private:
 	bool job_recorded = false;
 	friend void binner(std::shared_ptr<Job> job, int tag, std::map<int, std::vector<std::shared_ptr<Job>>> &destination);
 	friend class Planner;
 	friend void jobExecutor(std::shared_ptr<Job> &j); //Used by the planner to run jobs.
+	friend void jobBatchExecutor(std::tuple<std::shared_ptr<Job>*, int> &batch);
 };
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #pragma once
+#include <stdint.h>
 
 namespace libaudioverse_implementation {
 
@@ -17,6 +18,8 @@ void interleaveSamples(unsigned int channels, unsigned int frames, unsigned int
 //primitive math operations.
 //It is safe to use these such that dest==a1 or dest==a2.
 void additionKernel(int length, float* a1, float* a2, float* dest);
+//Replace a with a+b and b with a-b.  Found in adding.cpp.
+void butterflyKernel(int length, float* a, float* b);
 void scalarAdditionKernel(int length, float c, float*a1, float* dest);
 void scalarMultiplicationKernel(int length, float c, float* a1, float* dest);
 void multiplicationKernel(int length, float* a1, float* a2, float* dest);
@@ -51,4 +54,20 @@ void staticResamplerKernel(int inputSr, int outputSr, int channels, int frames,
 
 /**Dot two vectors.*/
 float dotKernel(int length, const float* v1, const float* v2);
+
+/**Sample format conversions, found in sample_formats.cpp.
+Floats are clamped to [-1, 1] before encoding to integer formats.*/
+void floatToInt16Kernel(int length, const float* input, int16_t* output);
+void int16ToFloatKernel(int length, const int16_t* input, float* output);
+//IEEE half precision, stored as raw bits.
+void floatToHalfKernel(int length, const float* input, uint16_t* output);
+void halfToFloatKernel(int length, const uint16_t* input, float* output);
+
+/**IMA ADPCM, in independently decodable blocks of ima_adpcm_block_frames samples.
+Encoding writes ceil(length/ima_adpcm_block_frames) blocks, padding the last with silence.
+Decoding reads samples start through start+count-1 of one block; this has to decode everything before start in that block too.*/
+const int ima_adpcm_block_frames = 256;
+const int ima_adpcm_block_bytes = 4+ima_adpcm_block_frames/2;
+void imaAdpcmEncodeKernel(int length, const float* input, unsigned char* output);
+void imaAdpcmDecodeKernel(const unsigned char* block, int start, int count, float* output);
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include "../libaudioverse.h"
+#include <functional>
+#include <memory>
+
+namespace libaudioverse_implementation {
+
+class Simulation;
+
+/**A process-wide pool of threads for decoding, resampling, and other slow work that must not happen under the simulation lock.
+
+There are two pools.
+The normal one is small, so that loads during play don't compete with the audio threads.
+The batch one has a thread per core, for loading lots of things at once while nothing much is playing.*/
+void initializeLoader();
+void shutdownLoader();
+
+//Threadsafe.
+void submitLoaderJob(std::function<void(void)> job, bool batch = false);
+
+/**Run load on the loader pool, and then report the outcome through the simulation's background task thread.
+
+Load should do everything slow outside the lock, and then lock the simulation only for long enough to swap its result in.
+Because the simulation holds its lock for the whole of a block, this means that the swap always happens between blocks.
+Any ErrorException thrown by load becomes the error passed to callback.
+If callback is null, it isn't called.
+If batch is true, this uses the batch pool.*/
+void submitAsyncLoad(std::shared_ptr<Simulation> simulation, std::function<void(void)> load, std::function<void(LavError)> callback, bool batch = false);
+
+}
@@ -73,6 +73,10 @@ class Node: public Job {
 	virtual void tickProperties();
 	//do not override. Handles the processing protocol (updating some globals and calling process) if needed for this tick, otherwise does nothing.
 	virtual void tick();
+	//Tick is these two around process; they're separate so that batches can process many nodes at once.
+	//beginTick returns false if there's nothing to do, in which case endTick must not be called.
+	bool beginTick();
+	void endTick();
 	//override this one instead. Default implementation merely zeros the outputs.
 	virtual void process();
 	//Apply mul and add.
@@ -6,6 +6,7 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <set>
 #include <vector>
 #include <memory>
+#include <tuple>
 #include <powercores/thread_pool.hpp>
 #include "job.hpp"
 
@@ -28,11 +29,17 @@ class Planner {
 	void replan(std::shared_ptr<Job> start);
 	//After every tick, kill the shared pointers so that we can let things die.
 	void clearStrongPlan();
+	//Find the batches in every bin of the strong plan.
+	void findBatches();
 	//Initialize the strong version of the plan from the weak pointers.
 	//This can invalidate the plan.
 	void initializeStrongPlan();
 	std::map<int, std::vector<std::shared_ptr<Job>>> plan;
 	std::map<int, std::vector<std::weak_ptr<Job>>> weak_plan;
+	//Runs of jobs to execute together, as (first, count), with the index of each bin's first run.
+	//Most runs are one job long.
+	std::vector<std::tuple<std::shared_ptr<Job>*, int>> batches;
+	std::vector<int> bin_batches;
 	bool is_valid = false;
 	std::weak_ptr<Job> last_start;
 	//For threads:
@@ -0,0 +1,24 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <memory>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+class ResponseSpectrum;
+
+void initializeResponseCache();
+void shutdownResponseCache();
+
+/**Get the spectrum of an impulse response, resampled from responseSr to sr and padded for convolvers of the given block size.
+
+The cache is keyed by a hash of the response's contents, so loading the same response through different paths or nodes only resamples and transforms it once.
+The cache only holds weak references: spectra are freed when the last convolver using them goes away.
+This is threadsafe.*/
+std::shared_ptr<ResponseSpectrum> getResponseSpectrum(int length, float* response, int responseSr, int sr, int blockSize);
+//Read one channel of a file and pass it through the above.
+std::shared_ptr<ResponseSpectrum> getResponseSpectrumFromFile(std::string path, int fileChannel, int sr, int blockSize);
+
+}
@@ -0,0 +1,28 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <memory>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+class BufferStorage;
+
+void initializeSampleCache();
+void shutdownSampleCache();
+
+/**Get the decoded contents of a file, resampled to sr and stored in format.
+
+Results are cached process-wide, so buffers loading the same file share one copy of its samples.
+Lookups go by the file's canonical path, size and modification time first; on a miss, the file is decoded and its samples hashed, so copies of one file at different paths are also only resampled and stored once.
+The cache holds strong references and evicts least recently used entries once it goes over its budget.
+Evicted storage lives on for as long as buffers use it.
+This is threadsafe.*/
+std::shared_ptr<BufferStorage> loadBufferStorageFromFile(std::string path, int sr, int format);
+
+//In bytes.  0 disables caching.  Lowering the budget evicts immediately.
+void setSampleCacheBudget(long long budget);
+long long getSampleCacheBudget();
+
+}
@@ -67,8 +67,8 @@ class Simulation: public Job {
 	//Set the block callback.
 	void setBlockCallback(LavBlockCallback cb, void* userdata);
 
-	//Write to a file.
-	void writeFile(std::string path, int channels, double duration, bool mayApplyMixingMatrix);
+	//Write to a file, optionally reporting progress after every chunk.
+	void writeFile(std::string path, int channels, double duration, bool mayApplyMixingMatrix, LavWriteFileProgressCallback callback = nullptr, void* userdata = nullptr);
 
 	//Thread support.
 	void setThreads(int n);
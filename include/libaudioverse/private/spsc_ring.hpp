@@ -0,0 +1,81 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace libaudioverse_implementation {
+
+/**A fixed-capacity, lock-free, single-producer single-consumer ring.
+
+Exactly one thread may call the producer functions and exactly one thread may call the consumer functions; the two may be different.
+Neither side ever blocks or allocates, which makes this safe to use from the audio thread in either role.
+The capacity is rounded up to a power of two.*/
+template<typename T>
+class SpscRing {
+	public:
+	SpscRing(unsigned int capacity) {
+		unsigned int c = 1;
+		while(c < capacity) c *= 2;
+		data.resize(c);
+		mask = c-1;
+	}
+
+	unsigned int getCapacity() {
+		return mask+1;
+	}
+
+	//Producer side.  Returns false if full.
+	bool push(const T& item) {
+		unsigned int w = write_index.load(std::memory_order_relaxed);
+		if(w-read_index.load(std::memory_order_acquire) > mask) return false;
+		data[w&mask] = item;
+		write_index.store(w+1, std::memory_order_release);
+		return true;
+	}
+
+	//Consumer side.  Returns false if empty.
+	bool pop(T& destination) {
+		unsigned int r = read_index.load(std::memory_order_relaxed);
+		if(r == write_index.load(std::memory_order_acquire)) return false;
+		destination = data[r&mask];
+		read_index.store(r+1, std::memory_order_release);
+		return true;
+	}
+
+	//Bulk versions of the above, for rings of samples.  These copy as many items as fit or are available and return how many that was.
+	unsigned int write(const T* items, unsigned int count) {
+		unsigned int w = write_index.load(std::memory_order_relaxed);
+		count = std::min(count, mask+1-(w-read_index.load(std::memory_order_acquire)));
+		unsigned int first = std::min(count, mask+1-(w&mask));
+		std::copy(items, items+first, data.begin()+(w&mask));
+		std::copy(items+first, items+count, data.begin());
+		write_index.store(w+count, std::memory_order_release);
+		return count;
+	}
+
+	unsigned int read(T* destination, unsigned int count) {
+		unsigned int r = read_index.load(std::memory_order_relaxed);
+		count = std::min(count, write_index.load(std::memory_order_acquire)-r);
+		unsigned int first = std::min(count, mask+1-(r&mask));
+		std::copy(data.begin()+(r&mask), data.begin()+(r&mask)+first, destination);
+		std::copy(data.begin(), data.begin()+(count-first), destination+first);
+		read_index.store(r+count, std::memory_order_release);
+		return count;
+	}
+
+	//An estimate when called from anywhere but the consumer, but never more than the true value when called from the consumer.
+	unsigned int size() {
+		return write_index.load(std::memory_order_acquire)-read_index.load(std::memory_order_acquire);
+	}
+
+	private:
+	std::vector<T> data;
+	unsigned int mask = 0;
+	//These only ever increase, and wrap.  Unsigned wrapping makes the subtraction above correct.
+	std::atomic<unsigned int> write_index{0}, read_index{0};
+};
+
+}
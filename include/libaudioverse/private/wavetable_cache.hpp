@@ -0,0 +1,20 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#pragma once
+#include <memory>
+
+namespace libaudioverse_implementation {
+
+class BandlimitedWavetable;
+enum class BandlimitedWaveforms;
+
+void initializeWavetableCache();
+void shutdownWavetableCache();
+
+/**Get the wavetable for a waveform at a sampling rate, building it if nothing is using one already.
+As with the impulse response cache, this only holds weak references, so tables are freed when the last oscillator using them goes away.
+This is threadsafe.*/
+std::shared_ptr<BandlimitedWavetable> getBandlimitedWavetable(BandlimitedWaveforms waveform, int sr);
+
+}
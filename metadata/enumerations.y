@@ -74,6 +74,24 @@ enumerations:
       Lav_BIQUAD_TYPE_LOWSHELF: Indicates a lowshelf filter.
       Lav_BIQUAD_TYPE_HIGHSHELF: Indicates a highshelf filter.
       Lav_BIQUAD_TYPE_IDENTITY: This filter does nothing.
+  Lav_BIQUAD_PRECISIONS:
+    doc_description: The arithmetic precision of a biquad filter.
+    members:
+      Lav_BIQUAD_PRECISION_DOUBLE: Double precision.  The most accurate.
+      Lav_BIQUAD_PRECISION_FLOAT: Single precision.  Faster, and accurate enough for most filters above about 100 Hz.
+  Lav_INTERPOLATION_TYPES:
+    doc_description: How to play buffers at rates other than 1.  Better interpolation costs more CPU.
+    members:
+      Lav_INTERPOLATION_TYPE_LINEAR: Linear interpolation.  The cheapest, but dulls high frequencies and adds some aliasing.
+      Lav_INTERPOLATION_TYPE_CUBIC: Cubic Hermite interpolation.  A good default for most pitched sounds.
+      Lav_INTERPOLATION_TYPE_SINC: An 8-tap windowed sinc.  The flattest response at high frequencies, and the most expensive.
+  Lav_BUFFER_STORAGE_FORMATS:
+    doc_description: How a buffer holds its samples in memory.  See {{"Lav_bufferSetStorageFormat"|function}}.
+    members:
+      Lav_BUFFER_STORAGE_FORMAT_FLOAT32: 32-bit floating point.  Lossless, and the fastest to play.
+      Lav_BUFFER_STORAGE_FORMAT_INT16: 16-bit integers.  Half the memory, with the quality of CD audio.
+      Lav_BUFFER_STORAGE_FORMAT_FLOAT16: 16-bit floating point.  Half the memory, with better quality than 16-bit integers for quiet sounds.
+      Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM: IMA ADPCM, about 4 bits a sample.  About an eighth of the memory, with audible loss on some material.
   Lav_DISTANCE_MODELS:
     doc_description: |
       used in the 3D components of this library.
@@ -88,6 +106,12 @@ enumerations:
       Lav_FDN_FILTER_TYPE_DISABLED: Don't insert filters on the feedback path.
       Lav_FDN_FILTER_TYPE_LOWPASS: Insert lowpass filters on the FDN's feedback path.
       Lav_FDN_FILTER_TYPE_HIGHPASS: Insert highpass filters on the FDN's feedback path.
+  Lav_FDN_MATRIX_STRUCTURES:
+    doc_description: The kind of feedback matrix a feedback delay network uses.
+    members:
+      Lav_FDN_MATRIX_STRUCTURE_GENERAL: Use the matrix property as is.  Costs the square of the line count per sample.
+      Lav_FDN_MATRIX_STRUCTURE_HOUSEHOLDER: A householder reflection about the vector (1, 1, 1, ...), followed by the feedback gains.  Costs the line count per sample.
+      Lav_FDN_MATRIX_STRUCTURE_HADAMARD: A normalized hadamard matrix, followed by the feedback gains.  Only available when the line count is a power of 2.  Costs the line count times its base 2 logarithm per sample.
   Lav_CHANNEL_INTERPRETATIONS:
     doc_description: Specifies how to treat inputs to this node for upmixing and downmixing.
     members:
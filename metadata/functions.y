@@ -255,6 +255,24 @@ functions:
       channels: The number of channels in the resulting file.
       duration: Duration of the resulting file, in seconds.
       mayApplyMixingMatrix: 1 if applying a mixing matrix should be attempted, 0 if extra channels should be treated as 0 or dropped.  This is the same behavior as with {{"Lav_simulationGetBlock"|function}}.
+  Lav_simulationWriteFileWithProgress:
+    category: simulations
+    doc_description: |
+      Like {{"Lav_simulationWriteFile"|function}}, but reports progress as it goes.
+      
+      Rendering happens on the calling thread and on the simulation's threads, while encoding and writing happen on another thread, so long renders are limited by the CPU rather than the disk.
+      Output is handed to the writer in chunks of about 65536 frames.
+      
+      The callback is called on the calling thread after every chunk is rendered.
+      It receives the simulation, the number of seconds rendered so far, the total number of seconds to render, the average rendering speed so far in frames per second, and the userdata.
+      Since the simulation is locked for the duration of the render, the callback must not use any other thread to access it.
+    params:
+      path: The path to the audio file to be written.
+      channels: The number of channels in the resulting file.
+      duration: Duration of the resulting file, in seconds.
+      mayApplyMixingMatrix: Same as for {{"Lav_simulationWriteFile"|function}}.
+      callback: The progress callback.  May be NULL.
+      userdata: An extra parameter that will be passed to the callback.
   Lav_simulationSetThreads:
     category: simulations
     doc_description: |
@@ -288,6 +306,40 @@ functions:
     params:
       bufferHandle: The buffer into which to load data.
       path: The path to the file to load data from.
+  Lav_bufferLoadFromFileAsync:
+    category: buffers
+    doc_description: |
+      Loads data into this buffer from a file, without blocking audio.
+      
+      The file is decoded and resampled on a background thread; the buffer's contents are then replaced between two blocks.
+      Until then, the buffer keeps its old contents.
+      
+      When the load finishes, the callback is called on the same background thread as other Libaudioverse callbacks with the buffer and an error code.
+      The error code is {{"Lav_ERROR_NONE"|codelit}} if the load succeeded.
+      If the buffer is put into use before the load finishes, the load fails with {{"Lav_ERROR_BUFFER_IN_USE"|codelit}}.
+    params:
+      bufferHandle: The buffer into which to load data.
+      path: The path to the file to load data from.
+      callback: Called when the load finishes. May be NULL.
+      userdata: An extra parameter that will be passed to the callback.
+  Lav_bufferLoadFromFilesBatch:
+    category: buffers
+    doc_description: |
+      Load many files into many buffers at once, using every core.
+      
+      This is {{"Lav_bufferLoadFromFileAsync"|function}} for a whole list of files.
+      The loads are spread over a pool with a thread per core, so loading hundreds of files is limited by the disk rather than by one core.
+      Since this competes with the audio threads, it is best used while loading levels and the like rather than during play.
+      
+      The callback is called once per buffer as each load finishes, in no particular order.
+      If any handle is invalid, any path is NULL, or any buffer is in use, this function fails and nothing is loaded.
+      Files aren't opened until their load runs, so a file that can't be read only fails its own load, which is reported through the callback.
+    params:
+      count: The number of buffers and paths.
+      bufferHandles: The buffers into which to load data.
+      paths: The paths to load, one per buffer.
+      callback: Called as each load finishes. May be NULL.
+      userdata: An extra parameter that will be passed to the callback.
   Lav_bufferLoadFromArray:
     category: buffers
     doc_description: |
@@ -321,6 +373,41 @@ functions:
       This function is primarily useful for estimating ram usage in caching structures.
     params:
       bufferHandle: The buffer whose length is to be queried.
+  Lav_bufferSetStorageFormat:
+    category: buffers
+    doc_description: |
+      Set how this buffer holds its samples in memory.
+      
+      Buffers default to {{"Lav_BUFFER_STORAGE_FORMAT_FLOAT32"|codelit}}.
+      The other formats use a half or less of the memory and are decoded as the buffer plays, which is useful for large banks of sounds.
+      Changing the format re-encodes the current contents, and everything loaded afterwards is stored in the new format.
+      All formats but {{"Lav_BUFFER_STORAGE_FORMAT_FLOAT32"|codelit}} are lossy, and converting back does not restore what was lost.
+    params:
+      bufferHandle: The buffer to change.
+      format: One of the {{"Lav_BUFFER_STORAGE_FORMATS"|enum}}.
+  Lav_bufferGetStorageFormat:
+    category: buffers
+    doc_description: |
+      Get the format this buffer stores its samples in.
+    params:
+      bufferHandle: The buffer to query.
+  Lav_setSampleCacheBudget:
+    category: buffers
+    doc_description: |
+      Set how much memory the sample cache may use, in megabytes.
+      
+      Loading a file into a buffer goes through a process-wide cache of decoded, resampled audio.
+      Buffers which load the same file share one copy of its samples, and loading a file again while it is cached is nearly instant.
+      Copies of one file at different paths are also detected.
+      When the cache goes over its budget, the least recently used files are dropped from it; buffers using them keep their contents.
+      
+      The default is 128 megabytes.  0 disables the cache.
+    params:
+      megabytes: The new budget.
+  Lav_getSampleCacheBudget:
+    category: buffers
+    doc_description: |
+      Get the sample cache's budget, in megabytes.
   Lav_nodeGetSimulation:
     category: nodes
     doc_description: |
@@ -40,6 +40,14 @@ properties:
     doc_description: |
       This property is a the gain in decibals to be used with the peaking and shelving filters.
       It measures the gain that these filters apply to the part of the signal they boost.
+  Lav_BIQUAD_PRECISION:
+    name: precision
+    type: int
+    default: Lav_BIQUAD_PRECISION_DOUBLE
+    value_enum: Lav_BIQUAD_PRECISIONS
+    doc_description: |
+      The precision the filter runs at.
+      Single precision processes 4 channels at once rather than 2, but can be noisy for filters with very low frequencies.
 inputs:
   - [constructor, "The signal to process."]
 outputs:
@@ -39,6 +39,14 @@ properties:
       if the buffer is configured to loop, the counter will count up every time the end of a loop is reached.
       Note that this property can technically wrap if your buffer node manages to end 2147483647 times.
       This should be impossible, save for the most long-running applications and shortest meaningful buffers.
+  Lav_BUFFER_INTERPOLATION:
+    name: interpolation
+    type: int
+    default: Lav_INTERPOLATION_TYPE_LINEAR
+    value_enum: Lav_INTERPOLATION_TYPES
+    doc_description: |
+      How to interpolate when the rate isn't 1.
+      At a rate of exactly 1, the buffer is copied without interpolation regardless of this property.
 callbacks:
   end:
     doc_description: |
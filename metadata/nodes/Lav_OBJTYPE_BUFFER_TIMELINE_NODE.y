@@ -1,3 +1,12 @@
+properties:
+  Lav_BUFFER_TIMELINE_INTERPOLATION:
+    name: interpolation
+    type: int
+    default: Lav_INTERPOLATION_TYPE_LINEAR
+    value_enum: Lav_INTERPOLATION_TYPES
+    doc_description: |
+      How to interpolate buffers scheduled with a pitch bend other than 1.
+      Changing this affects buffers which are already scheduled.
 extra_functions:
   Lav_bufferTimelineNodeScheduleBuffer:
     doc_description: |
@@ -27,6 +27,31 @@ properties:
       
       The matrix is stored in row-major order.
       The supplied array must have a length equal to the square of the channels specified to the constructor.
+      
+      This property is ignored unless {{"Lav_FDN_MATRIX_STRUCTURE"|codelit}} is {{"Lav_FDN_MATRIX_STRUCTURE_GENERAL"|codelit}}.
+  Lav_FDN_MATRIX_STRUCTURE:
+    name: matrix_structure
+    type: int
+    default: Lav_FDN_MATRIX_STRUCTURE_GENERAL
+    range: dynamic
+    value_enum: Lav_FDN_MATRIX_STRUCTURES
+    doc_description: |
+      Whether to use the matrix property or a structured matrix.
+      
+      Structured matrices are applied directly rather than by multiplication, which makes large networks much cheaper.
+      Hadamard matrices are only available when the number of lines is a power of 2.
+  Lav_FDN_FEEDBACK_GAINS:
+    name: feedback_gains
+    type: float_array
+    dynamic_array: true
+    doc_description: |
+      The gain applied to each line's feedback after a structured matrix.
+      These are ignored by general matrices, which should include their own gains.
+      
+      Every structured matrix is orthogonal, so the network only decays if these are less than 1 in magnitude: gains of exactly 1 give a lossless network which rings forever.
+      The default is 0.9 for every line.
+      How quickly the network decays depends on both these gains and the delays, so most uses will want to set them from a desired decay time.
+      This array must be {{"channels"|codelit}} long.
   Lav_FDN_FILTER_TYPES:
     name: filter_types
     type: int_array
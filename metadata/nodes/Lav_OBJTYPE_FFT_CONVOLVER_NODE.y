@@ -13,6 +13,18 @@ extra_functions:
       path: The path to the file.
       fileChannel: The channel of the file to use as the response.
       convolverChannel: The channel for which the response is to be set.
+  Lav_fftConvolverNodeSetResponseFromFileAsync:
+    doc_description: |
+      Like {{"Lav_fftConvolverNodeSetResponseFromFile"|function}}, but the file is read, resampled, and transformed on a background thread.
+      The node keeps its old response until the new one is ready, and then switches between two blocks.
+      
+      The callback is called with this node and an error code when the load finishes.
+    params:
+      path: The path to the file.
+      fileChannel: The channel of the file to use as the response.
+      convolverChannel: The channel for which the response is to be set.
+      callback: Called when the load finishes. May be NULL.
+      userdata: An extra parameter that will be passed to the callback.
 inputs:
   - [constructor, "The signal to be convolved."]
 outputs:
@@ -0,0 +1,47 @@
+properties:
+  Lav_FILE_STREAMER_POSITION:
+    name: position
+    type: double
+    default: 0.0
+    range: dynamic
+    doc_description: |
+      The position of playback, in seconds.
+      The range of this property corresponds to the total duration of the file.
+      Setting this property seeks.
+  Lav_FILE_STREAMER_LOOPING:
+    name: looping
+    type: boolean
+    default: 0
+    doc_description: |
+      If true, this node continues playing from the beginning of the file after it reaches the end.
+  Lav_FILE_STREAMER_ENDED_COUNT:
+    name: ended_count
+    type: int
+    default: 0
+    read_only: true
+    doc_description: |
+      Increments every time the file reaches its end.
+      As with the {{"Lav_OBJTYPE_BUFFER_NODE"|node}}, this counts loops if the node is looping.
+extra_functions:
+  Lav_fileStreamerNodeSetEndCallback:
+    doc_description: |
+      Set the callback to be called when the file reaches its end.
+    params:
+      callback: The callback, or NULL to clear.
+      userdata: An extra parameter that will be passed to the callback.
+callbacks:
+  end:
+    doc_description: |
+      Called outside the audio threads every time the file reaches its end.
+inputs: null
+outputs:
+  - [ constructor, "The number of channels in the file.", "The audio from the file."]
+doc_name: file streamer
+doc_description: |
+  Plays a file from disk without loading all of it into memory.
+  
+  Unlike a {{"Lav_OBJTYPE_BUFFER_NODE"|node}}, which decodes the whole file up front, this node keeps only about half a second of audio in memory.
+  A background thread reads and resamples ahead of playback.
+  Use this node for music and other long audio, and buffers for short sounds which are played often.
+  
+  Seeking is not instantaneous: after setting the position, this node outputs silence until the background thread catches up, usually within a block or two.
@@ -1,12 +1,40 @@
+properties:
+  Lav_GRAPH_LISTENER_TAP_ENABLED:
+    name: tap_enabled
+    type: boolean
+    default: 0
+    doc_description: |
+      If true, every block is also copied into the tap, from which it can be read with {{"Lav_graphListenerNodeReadTap"|function}}.
+  Lav_GRAPH_LISTENER_TAP_OVERRUNS:
+    name: tap_overruns
+    type: int
+    default: 0
+    read_only: true
+    doc_description: |
+      The number of blocks dropped because the tap was full.
+      The tap holds about a second of audio, so this only increases if nothing is reading it.
 callbacks:
   listening:
     doc_description: |
       When set, audio is passed to this callback every block.
       This callback is called inside the audio threads; do not block.
+      If you only need to observe the audio, the tap is usually a better choice.
     params:
       frames: The number of frames of audio being made available to client code.  This should always be the same as the simulation's block size.
       channels: The number of channels of audio being made available to client code.
       buffer: The data, stored in interleaved format.  The length of this buffer is {{"frames*channels"|codelit}}.
+extra_functions:
+  Lav_graphListenerNodeReadTap:
+    doc_description: |
+      Read interleaved audio from the tap.
+      
+      This function does not lock the simulation and never waits on audio mixing, so it can be polled as often as needed.
+      Only one thread may read a given graph listener's tap at a time.
+      Nothing is written to the tap unless {{"Lav_GRAPH_LISTENER_TAP_ENABLED"|codelit}} is true.
+    params:
+      frames: The maximum number of frames to read.
+      destination: Where to put the audio.  Must have room for {{"frames*channels"|codelit}} samples.
+      framesRead: How many frames were actually read, which is 0 if the tap is empty.
 inputs:
   - [constructor, "The audio which will be passed to the associated callback."]
 outputs:
@@ -7,7 +7,7 @@ extra_functions:
       numerator: The numerator of the transfer function.
       denominatorLength: The number of coefficients in the denominator of the transfer function.  Must be at least 1.
       denominator: The denominator of the transfer function.  The first coefficient must be nonzero.
-      shouldClearHistory: 1 if we should reset the internal histories, otherwise 0.
+      shouldClearHistory: 1 if we should reset the internal histories, otherwise 0.  Histories are also reset if the new filter factors into a different number of sections than the old one.
 inputs:
   - [constructor, "The signal to filter."]
 outputs:
@@ -16,4 +16,7 @@ doc_name: IIR filter
 doc_description: |
   Implements arbetrary IIR filters.
   The only restriction on the filter is that the first element of the denominator must be nonzero.
-  To configure this node, use the function Lav_iirNodeSetCoefficients.
\ No newline at end of file
+  To configure this node, use the function Lav_iirNodeSetCoefficients.
+  
+  Where possible, the filter is factored into a cascade of second-order sections, which is both faster and more numerically stable at high orders.
+  Filters which can't be factored, for example those which begin with a delay, are evaluated directly.
\ No newline at end of file
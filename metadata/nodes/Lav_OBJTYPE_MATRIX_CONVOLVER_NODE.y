@@ -0,0 +1,33 @@
+extra_functions:
+  Lav_matrixConvolverNodeSetResponse:
+    doc_description: |
+      Set the response from an input channel to an output channel.
+      
+      A length of 0 disconnects the pair, so that the input channel no longer contributes to the output channel.
+      If this changes the length of the longest response, the history of the node is cleared.
+    params:
+      inputChannel: The input channel.
+      outputChannel: The output channel.
+      length: The length of the response in samples.
+      response: The new response.
+  Lav_matrixConvolverNodeSetResponseFromFile:
+    doc_description: |
+      Set the response from an input channel to an output channel from a file.
+    params:
+      path: The path to the file.
+      fileChannel: The channel of the file to use as the response.
+      inputChannel: The input channel.
+      outputChannel: The output channel.
+inputs:
+  - [constructor, "The signal to be convolved."]
+outputs:
+  - [constructor, "The sum of each input channel convolved with its response for each output channel."]
+doc_name: matrix convolver
+doc_description: |
+  A convolver with a response for every pair of input and output channels.
+  
+  This node is intended for true stereo and ambisonic reverbs, where every output is a mix of every input convolved with a different response.
+  Each input channel is transformed once per block, no matter how many outputs it feeds, so this node is much faster than building the same matrix from several {{"Lav_OBJTYPE_FFT_CONVOLVER_NODE"|node}}s.
+  
+  By default, input channel i is connected to output channel i with an impulse, and all other pairs are disconnected.
+  All responses are padded to the length of the longest one.
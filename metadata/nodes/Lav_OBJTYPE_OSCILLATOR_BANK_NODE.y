@@ -0,0 +1,42 @@
+properties:
+  Lav_OSCILLATOR_BANK_FREQUENCIES:
+    name: frequencies
+    type: float_array
+    dynamic_array: true
+    doc_description: |
+      The frequency of each oscillator in HZ.
+      This array must be exactly as long as the number of oscillators specified to the constructor.
+      The default is 0 for all oscillators, so this node is silent until this property is set.
+  Lav_OSCILLATOR_BANK_AMPLITUDES:
+    name: amplitudes
+    type: float_array
+    dynamic_array: true
+    doc_description: |
+      The amplitude of each oscillator.
+      This array must be exactly as long as the number of oscillators specified to the constructor.
+  Lav_OSCILLATOR_BANK_PHASES:
+    name: phases
+    type: float_array
+    dynamic_array: true
+    doc_description: |
+      The phase of each oscillator, measured in periods.
+      Setting this property moves every oscillator to the specified phase.
+  Lav_OSCILLATOR_FREQUENCY_MULTIPLIER:
+    name: frequency_multiplier
+    type: float
+    default: 1.0
+    range: [-INFINITY, INFINITY]
+    doc_description: |
+      A multiplicative factor applied to the frequency of every oscillator.
+      
+      Changing this property transposes the whole bank without rewriting the frequencies.
+inputs: null
+outputs:
+  - [1, "The sum of all oscillators."]
+doc_name: oscillator bank
+doc_description: |
+  Many sine oscillators summed into one output, for additive synthesis.
+  
+  This node is equivalent to a {{"Lav_OBJTYPE_SINE_NODE"|node}} for each oscillator, all connected to a gain node.
+  It is much faster than that, because all the oscillators are advanced together and there are no connections to mix.
+  Frequencies, amplitudes, and the multiplier are only read at the start of each block.
@@ -6,10 +6,22 @@ properties:
     default: 0.03
     doc_description: |
       When the remaining audio in the push node has a duration less than this property, the low callback is called.
+  Lav_PUSH_DROPPED_FRAMES:
+    name: dropped_frames
+    type: int
+    default: 0
+    read_only: true
+    doc_description: |
+      The number of frames that have been dropped because the internal queue was full.
+      The queue holds at least 2 seconds of audio.
 extra_functions:
   Lav_pushNodeFeed:
     doc_description: |
       Feed more audio data into the internal queue.
+      
+      This function does not lock the simulation and never waits on audio mixing, so it is safe to call from a thread which must not block.
+      Only one thread may feed a given push node at a time.
+      If the queue does not have room for all of the audio, the remainder is dropped and counted in {{"Lav_PUSH_DROPPED_FRAMES"|codelit}}.
     params:
       length: The length of the buffer, in samples.
       frames: The buffer to feed into the node.  This memory is copied.
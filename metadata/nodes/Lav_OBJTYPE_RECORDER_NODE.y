@@ -1,3 +1,24 @@
+properties:
+  Lav_RECORDER_BUFFER_DURATION:
+    name: buffer_duration
+    type: double
+    default: 1.0
+    range: [0.0, 60.0]
+    doc_description: |
+      How much audio, in seconds, may be waiting to be written to disk at once.
+      The buffer is allocated up front, so this is limited to one minute.
+      
+      Recording happens on a background thread.
+      If the disk falls further behind than this, blocks are dropped and counted in {{"Lav_RECORDER_DROPPED_BLOCKS"|codelit}} instead of blocking audio.
+      This is read when recording starts; changing it during a recording has no effect until the next one.
+  Lav_RECORDER_DROPPED_BLOCKS:
+    name: dropped_blocks
+    type: int
+    default: 0
+    read_only: true
+    doc_description: |
+      The number of blocks dropped because the disk couldn't keep up, since recording last started.
+      If this is ever nonzero, increase {{"Lav_RECORDER_BUFFER_DURATION"|codelit}}.
 extra_functions:
   Lav_recorderNodeStartRecording:
     doc_description: |
@@ -103,6 +103,14 @@ properties:
       It is extremely difficult to map occlusion to a physical quantity.
       In the real world, occlusion depends on mass, density, molecular structure, and a huge number of other factors.
       Libaudioverse therefore chooses to use this scalar quantity and to attempt to do the right thing.
+  Lav_SOURCE_OCCLUSION_PRECISION:
+    name: occlusion_precision
+    type: int
+    default: Lav_BIQUAD_PRECISION_FLOAT
+    value_enum: Lav_BIQUAD_PRECISIONS
+    doc_description: |
+      The precision of the filter used for occlusion.
+      Single precision is cheaper and is more than adequate for the occlusion filter, so this rarely needs changing.
 extra_functions:
   Lav_sourceNodeFeedEffect:
     doc_description: |
@@ -71,6 +71,7 @@ void SourceNode::forwardProperties() {
 	auto strong = std::static_pointer_cast<Node>(shared_from_this());
 	panner_node->forwardProperty(Lav_PANNER_STRATEGY, strong, Lav_SOURCE_PANNER_STRATEGY);
 	panner_node->forwardProperty(Lav_NODE_STATE, strong, Lav_NODE_STATE);
+	occluder->forwardProperty(Lav_BIQUAD_PRECISION, strong, Lav_SOURCE_OCCLUSION_PRECISION);
 	//All the other exit points can be handled by forwarding states of the effect gains.
 	
 	//Occlusion callback.
@@ -3,6 +3,7 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 
 #include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
 #include <libaudioverse/private/file.hpp>
 #include <libaudioverse/private/buffer.hpp>
 #include <libaudioverse/private/simulation.hpp>
@@ -10,12 +11,106 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/memory.hpp>
 #include <libaudioverse/private/error.hpp>
 #include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/loader.hpp>
+#include <libaudioverse/private/sample_cache.hpp>
 #include <algorithm>
 #include <atomic>
+#include <string>
+#include <functional>
+#include <vector>
 
 
 namespace libaudioverse_implementation {
 
+long long encodedChannelBytes(int format, int frames) {
+	switch(format) {
+		case Lav_BUFFER_STORAGE_FORMAT_INT16:
+		case Lav_BUFFER_STORAGE_FORMAT_FLOAT16:
+		return 2LL*frames;
+		case Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM:
+		return (long long)ima_adpcm_block_bytes*((frames+ima_adpcm_block_frames-1)/ima_adpcm_block_frames);
+	}
+	return 0;
+}
+
+BufferStorage::BufferStorage(int channels, int frames, int format, float* data): channels(channels), frames(frames), format(format) {
+	if(format == Lav_BUFFER_STORAGE_FORMAT_FLOAT32) {
+		this->data = data;
+		return;
+	}
+	encoded_channel_bytes = encodedChannelBytes(format, frames);
+	encoded_data = new unsigned char[encoded_channel_bytes*channels];
+	for(int ch = 0; ch < channels; ch++) {
+		float* in = data+ch*frames;
+		unsigned char* out = encoded_data+ch*encoded_channel_bytes;
+		switch(format) {
+			case Lav_BUFFER_STORAGE_FORMAT_INT16: floatToInt16Kernel(frames, in, (int16_t*)out); break;
+			case Lav_BUFFER_STORAGE_FORMAT_FLOAT16: floatToHalfKernel(frames, in, (uint16_t*)out); break;
+			case Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM: imaAdpcmEncodeKernel(frames, in, out); break;
+		}
+	}
+	delete[] data;
+}
+
+BufferStorage::~BufferStorage() {
+	if(data) delete[] data;
+	if(encoded_data) delete[] encoded_data;
+}
+
+int BufferStorage::getChannels() {
+	return channels;
+}
+
+int BufferStorage::getFrames() {
+	return frames;
+}
+
+int BufferStorage::getFormat() {
+	return format;
+}
+
+long long BufferStorage::getMemoryUsage() {
+	if(format == Lav_BUFFER_STORAGE_FORMAT_FLOAT32) return (long long)sizeof(float)*channels*frames;
+	return encoded_channel_bytes*channels;
+}
+
+void BufferStorage::readFrames(int frame, int channel, int count, float* destination) {
+	if(format == Lav_BUFFER_STORAGE_FORMAT_FLOAT32) {
+		std::copy(data+channel*frames+frame, data+channel*frames+frame+count, destination);
+		return;
+	}
+	unsigned char* channelData = encoded_data+channel*encoded_channel_bytes;
+	switch(format) {
+		case Lav_BUFFER_STORAGE_FORMAT_INT16:
+		int16ToFloatKernel(count, ((int16_t*)channelData)+frame, destination);
+		break;
+		case Lav_BUFFER_STORAGE_FORMAT_FLOAT16:
+		halfToFloatKernel(count, ((uint16_t*)channelData)+frame, destination);
+		break;
+		case Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM:
+		while(count > 0) {
+			int block = frame/ima_adpcm_block_frames, offset = frame%ima_adpcm_block_frames;
+			int got = std::min(count, ima_adpcm_block_frames-offset);
+			imaAdpcmDecodeKernel(channelData+block*ima_adpcm_block_bytes, offset, got, destination);
+			frame += got;
+			destination += got;
+			count -= got;
+		}
+		break;
+	}
+}
+
+float* BufferStorage::getPointer(int frame, int channel) {
+	if(format != Lav_BUFFER_STORAGE_FORMAT_FLOAT32) return nullptr;
+	return data+channel*frames+frame;
+}
+
+float* BufferStorage::decodeAll() {
+	float* out = new float[channels*frames];
+	for(int ch = 0; ch < channels; ch++) readFrames(0, ch, frames, out+ch*frames);
+	return out;
+}
+
 Buffer::Buffer(std::shared_ptr<Simulation> simulation): ExternalObject(Lav_OBJTYPE_BUFFER) {
 	this->simulation = simulation;
 }
@@ -25,7 +120,6 @@ std::shared_ptr<Buffer> createBuffer(std::shared_ptr<Simulation>simulation) {
 }
 
 Buffer::~Buffer() {
-	if(data) delete[] data;
 }
 
 std::shared_ptr<Simulation> Buffer::getSimulation() {
@@ -44,37 +138,82 @@ int Buffer::getChannels() {
 	return channels;
 }
 
-void Buffer::loadFromArray(int sr, int channels, int frames, float* inputData) {
-	int simulationSr= (int)simulation->getSr();
-	staticResamplerKernel(sr, simulationSr, channels, frames, inputData, &(this->frames), &data);
+float* prepareBufferData(int inputSr, int outputSr, int channels, int frames, float* inputData, int* framesOut) {
+	float* data = nullptr;
+	staticResamplerKernel(inputSr, outputSr, channels, frames, inputData, framesOut, &data);
 	if(data==nullptr) ERROR(Lav_ERROR_MEMORY);
-	this->channels = channels;
-	if(this->channels == 1) return; //It's already uninterleaved.
+	if(channels == 1) return data; //It's already uninterleaved.
 	//Uninterleave the data and delete the old one.
-	float* newData = new float[this->channels*this->frames];
-	for(int ch = 0; ch < this->channels; ch++) {
-		for(int i = 0; i < this->frames; i++) {
-			newData[ch*this->frames+i] = data[this->channels*i+ch];
+	float* newData = new float[channels*(*framesOut)];
+	for(int ch = 0; ch < channels; ch++) {
+		for(int i = 0; i < *framesOut; i++) {
+			newData[ch*(*framesOut)+i] = data[channels*i+ch];
 		}
 	}
 	delete[] data;
-	data = newData;
+	return newData;
+}
+
+void Buffer::loadFromArray(int sr, int channels, int frames, float* inputData) {
+	int simulationSr= (int)simulation->getSr();
+	int newFrames;
+	float* newData = prepareBufferData(sr, simulationSr, channels, frames, inputData, &newFrames);
+	replaceData(channels, newFrames, newData);
+}
+
+void Buffer::replaceData(int channels, int frames, float* data) {
+	setStorage(std::make_shared<BufferStorage>(channels, frames, storage_format, data));
+}
+
+void Buffer::setStorage(std::shared_ptr<BufferStorage> storage) {
+	this->storage = storage;
+	channels = storage ? storage->getChannels() : 0;
+	frames = storage ? storage->getFrames() : 0;
+}
+
+std::shared_ptr<BufferStorage> Buffer::getStorage() {
+	return storage;
+}
+
+int Buffer::getStorageFormat() {
+	return storage_format;
+}
+
+void Buffer::setStorageFormat(int format) {
+	if(format < Lav_BUFFER_STORAGE_FORMAT_FLOAT32 || format > Lav_BUFFER_STORAGE_FORMAT_IMA_ADPCM) ERROR(Lav_ERROR_RANGE, "Invalid storage format.");
+	if(format == storage_format) return;
+	storage_format = format;
+	if(storage) replaceData(channels, frames, storage->decodeAll());
+}
+
+long long Buffer::getMemoryUsage() {
+	return storage ? storage->getMemoryUsage() : 0;
 }
 
 float Buffer::getSample(int frame, int channel) {
-	return data[frames*channel+frame];
+	float s;
+	storage->readFrames(frame, channel, 1, &s);
+	return s;
+}
+
+void Buffer::readFrames(int frame, int channel, int count, float* destination) {
+	storage->readFrames(frame, channel, count, destination);
 }
 
 float* Buffer::getPointer(int frame, int channel) {
-	return data+channel*frames+frame;
+	return storage ? storage->getPointer(frame, channel) : nullptr;
 }
 
 void Buffer::normalize() {
-	float min = *std::min_element(data, data+channels*frames);
-	float max = *std::max_element(data, data+channels*frames);
+	if(channels == 0 || frames == 0) return;
+	//The storage may be shared, so this always works on a copy.
+	float* samples = storage->decodeAll();
+	float min = *std::min_element(samples, samples+channels*frames);
+	float max = *std::max_element(samples, samples+channels*frames);
 	float normfactor = std::max(fabs(min), fabs(max));
 	normfactor = 1.0f/normfactor;
-	scalarMultiplicationKernel(channels*frames, normfactor, data, data);
+	scalarMultiplicationKernel(channels*frames, normfactor, samples, samples);
+	replaceData(channels, frames, samples);
 }
 
 void Buffer::lock() {
@@ -93,12 +232,31 @@ void Buffer::decrementUseCount() {
 	use_count.fetch_add(-1);
 }
 
+bool Buffer::isInUse() {
+	return use_count.load() != 0;
+}
+
 void Buffer::throwIfInUse() {
 	if(use_count.load()) {
 		ERROR(Lav_ERROR_BUFFER_IN_USE, "You cannot modify buffers while something is using their data.");
 	}
 }
 
+//Shared by the asynchronous loading functions.  Call after checking that the buffer isn't in use.
+void submitBufferLoad(std::shared_ptr<Buffer> buff, int format, std::string path, LavAsyncLoadCallback callback, void* userdata, bool batch) {
+	auto load = [buff, path, format] () {
+		auto storage = loadBufferStorageFromFile(path, (int)buff->getSimulation()->getSr(), format);
+		LOCK(*buff);
+		if(buff->isInUse()) ERROR(Lav_ERROR_BUFFER_IN_USE, "Buffer was put into use before the load finished.");
+		buff->setStorage(storage);
+	};
+	std::function<void(LavError)> cb;
+	if(callback) cb = [buff, callback, userdata] (LavError result) {
+		callback(outgoingObject(buff), result, userdata);
+	};
+	submitAsyncLoad(buff->getSimulation(), load, cb, batch);
+}
+
 //begin public api
 
 Lav_PUBLIC_FUNCTION LavError Lav_createBuffer(LavHandle simulationHandle, LavHandle* destination) {
@@ -118,17 +276,52 @@ Lav_PUBLIC_FUNCTION LavError Lav_bufferGetSimulation(LavHandle handle, LavHandle
 
 Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFile(LavHandle bufferHandle, const char* path) {
 	PUB_BEGIN
+	if(path == nullptr) ERROR(Lav_ERROR_NULL_POINTER);
 	auto buff =incomingObject<Buffer>(bufferHandle);
-	FileReader f{};
-	f.open(path);
-	float* data = allocArray<float>(f.getSampleCount());
-	f.readAll(data);
+	int format;
 	{
 		LOCK(*buff);
 		buff->throwIfInUse();
-		buff->loadFromArray(f.getSr(), f.getChannelCount(), f.getSampleCount()/f.getChannelCount(), data);
+		format = buff->getStorageFormat();
 	}
-	freeArray(data);
+	auto storage = loadBufferStorageFromFile(path, (int)buff->getSimulation()->getSr(), format);
+	LOCK(*buff);
+	buff->throwIfInUse();
+	buff->setStorage(storage);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFileAsync(LavHandle bufferHandle, const char* path, LavAsyncLoadCallback callback, void* userdata) {
+	PUB_BEGIN
+	if(path == nullptr) ERROR(Lav_ERROR_NULL_POINTER);
+	auto buff =incomingObject<Buffer>(bufferHandle);
+	int format;
+	{
+		LOCK(*buff);
+		buff->throwIfInUse();
+		format = buff->getStorageFormat();
+	}
+	submitBufferLoad(buff, format, path, callback, userdata, false);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_bufferLoadFromFilesBatch(int count, LavHandle* bufferHandles, const char** paths, LavAsyncLoadCallback callback, void* userdata) {
+	PUB_BEGIN
+	if(count < 0) ERROR(Lav_ERROR_RANGE, "Count must not be negative.");
+	if(count > 0 && (bufferHandles == nullptr || paths == nullptr)) ERROR(Lav_ERROR_NULL_POINTER);
+	//Check everything first, so that a bad handle, a null path, or a buffer in use means nothing starts.
+	//Files are only opened by the loads themselves, so one that can't be read fails alone and is reported through the callback.
+	std::vector<std::shared_ptr<Buffer>> buffers;
+	std::vector<int> formats;
+	for(int i = 0; i < count; i++) {
+		if(paths[i] == nullptr) ERROR(Lav_ERROR_NULL_POINTER, "Null path.");
+		auto buff = incomingObject<Buffer>(bufferHandles[i]);
+		LOCK(*buff);
+		buff->throwIfInUse();
+		buffers.push_back(buff);
+		formats.push_back(buff->getStorageFormat());
+	}
+	for(int i = 0; i < count; i++) submitBufferLoad(buffers[i], formats[i], paths[i], callback, userdata, true);
 	PUB_END
 }
 
@@ -166,4 +359,21 @@ Lav_PUBLIC_FUNCTION LavError Lav_bufferGetLengthInSamples(LavHandle bufferHandle
 	PUB_END
 }
 
+Lav_PUBLIC_FUNCTION LavError Lav_bufferSetStorageFormat(LavHandle bufferHandle, int format) {
+	PUB_BEGIN
+	auto b = incomingObject<Buffer>(bufferHandle);
+	LOCK(*b);
+	b->throwIfInUse();
+	b->setStorageFormat(format);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_bufferGetStorageFormat(LavHandle bufferHandle, int* destination) {
+	PUB_BEGIN
+	auto b = incomingObject<Buffer>(bufferHandle);
+	LOCK(*b);
+	*destination = b->getStorageFormat();
+	PUB_END
+}
+
 }
\ No newline at end of file
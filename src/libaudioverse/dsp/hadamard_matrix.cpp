@@ -29,4 +29,14 @@ void hadamard(int n, float* buffer, bool shouldNormalize) {
 	}
 }
 
+void hadamardTransform(int n, int length, float* buffer) {
+	//Each stage pairs every row with the row half a group away.
+	//Since rows are contiguous, each group is two contiguous spans of half*length floats, so the butterflies are long and vectorize.
+	for(int half = 1; half < n; half *= 2) {
+		for(int group = 0; group < n; group += half*2) {
+			butterflyKernel(half*length, buffer+group*length, buffer+(group+half)*length);
+		}
+	}
+}
+
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/private/kernels.hpp>
 #include <math.h>
+#include <algorithm>
 
 namespace libaudioverse_implementation {
 
@@ -26,4 +27,12 @@ void householder(int n, float* buffer, bool shouldNormalize) {
 	}
 }
 
+void householderReflection(int n, int length, float* buffer, float* scratch) {
+	//Every row loses 2/n of the sum of all rows.
+	std::fill(scratch, scratch+length, 0.0f);
+	for(int i = 0; i < n; i++) additionKernel(length, scratch, buffer+i*length, scratch);
+	float subtracting = -2.0f/n;
+	for(int i = 0; i < n; i++) multiplicationAdditionKernel(length, subtracting, scratch, buffer+i*length, buffer+i*length);
+}
+
 }
\ No newline at end of file
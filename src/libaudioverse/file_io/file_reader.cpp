@@ -65,6 +65,11 @@ unsigned int FileReader::read(unsigned int frames, float* buffer) {
 	return (unsigned int)sf_readf_float(handle, buffer, frames);
 }
 
+void FileReader::seek(unsigned int frame) {
+	if(handle == NULL) ERROR(Lav_ERROR_FILE, "Attempt to seek without opening first.");
+	if(sf_seek(handle, frame, SEEK_SET) == -1) ERROR(Lav_ERROR_FILE, "Unable to seek.");
+}
+
 unsigned int FileReader::readAll(float* buffer) {
 	return read(getFrameCount(), buffer);
 }
@@ -0,0 +1,195 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/implementations/biquad_bank.hpp>
+#include <libaudioverse/implementations/biquad.hpp>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <algorithm>
+#include <mmintrin.h>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace libaudioverse_implementation {
+
+BiquadBank::BiquadBank(float sr, int lanes, bool doublePrecision): sr(sr), double_precision(doublePrecision) {
+	setLaneCount(lanes);
+}
+
+int BiquadBank::getLaneCount() {
+	return lanes;
+}
+
+void BiquadBank::setLaneCount(int lanes) {
+	b0.resize(lanes, 1.0);
+	b1.resize(lanes, 0.0);
+	b2.resize(lanes, 0.0);
+	a1.resize(lanes, 0.0);
+	a2.resize(lanes, 0.0);
+	b0f.resize(lanes, 1.0f);
+	b1f.resize(lanes, 0.0f);
+	b2f.resize(lanes, 0.0f);
+	a1f.resize(lanes, 0.0f);
+	a2f.resize(lanes, 0.0f);
+	s1.resize(lanes, 0.0);
+	s2.resize(lanes, 0.0);
+	s1f.resize(lanes, 0.0f);
+	s2f.resize(lanes, 0.0f);
+	this->lanes = lanes;
+}
+
+bool BiquadBank::getDoublePrecision() {
+	return double_precision;
+}
+
+void BiquadBank::setDoublePrecision(bool doublePrecision) {
+	if(doublePrecision == double_precision) return;
+	for(int i = 0; i < lanes; i++) {
+		if(doublePrecision) {
+			s1[i] = s1f[i];
+			s2[i] = s2f[i];
+		}
+		else {
+			s1f[i] = (float)s1[i];
+			s2f[i] = (float)s2[i];
+		}
+	}
+	double_precision = doublePrecision;
+}
+
+void BiquadBank::configure(int lane, int type, double frequency, double dbGain, double q) {
+	double nb0, nb1, nb2, na0, na1, na2;
+	biquadConfigurationImplementation(sr, type, frequency, dbGain, q, nb0, nb1, nb2, na0, na1, na2);
+	setCoefficients(lane, nb0/na0, nb1/na0, nb2/na0, na1/na0, na2/na0);
+}
+
+void BiquadBank::configureAll(int type, double frequency, double dbGain, double q) {
+	double nb0, nb1, nb2, na0, na1, na2;
+	biquadConfigurationImplementation(sr, type, frequency, dbGain, q, nb0, nb1, nb2, na0, na1, na2);
+	for(int i = 0; i < lanes; i++) setCoefficients(i, nb0/na0, nb1/na0, nb2/na0, na1/na0, na2/na0);
+}
+
+void BiquadBank::setCoefficients(int lane, double b0, double b1, double b2, double a1, double a2) {
+	this->b0[lane] = b0;
+	this->b1[lane] = b1;
+	this->b2[lane] = b2;
+	this->a1[lane] = a1;
+	this->a2[lane] = a2;
+	b0f[lane] = (float)b0;
+	b1f[lane] = (float)b1;
+	b2f[lane] = (float)b2;
+	a1f[lane] = (float)a1;
+	a2f[lane] = (float)a2;
+}
+
+void BiquadBank::reset() {
+	for(int i = 0; i < lanes; i++) reset(i);
+}
+
+void BiquadBank::reset(int lane) {
+	s1[lane] = 0.0;
+	s2[lane] = 0.0;
+	s1f[lane] = 0.0f;
+	s2f[lane] = 0.0f;
+}
+
+void BiquadBank::copyLane(BiquadBank &from, int fromLane, BiquadBank &to, int toLane) {
+	to.setCoefficients(toLane, from.b0[fromLane], from.b1[fromLane], from.b2[fromLane], from.a1[fromLane], from.a2[fromLane]);
+	double h1 = from.double_precision ? from.s1[fromLane] : from.s1f[fromLane];
+	double h2 = from.double_precision ? from.s2[fromLane] : from.s2f[fromLane];
+	to.s1[toLane] = h1;
+	to.s2[toLane] = h2;
+	to.s1f[toLane] = (float)h1;
+	to.s2f[toLane] = (float)h2;
+}
+
+void BiquadBank::process(int blockSize, float** inputs, float** outputs) {
+	if(double_precision) processDouble(blockSize, inputs, outputs);
+	else processFloat(blockSize, inputs, outputs);
+}
+
+//One lane at a time, for builds without SSE2 and for whatever doesn't fill a group.
+template<typename T>
+void biquadBankLaneSimple(int blockSize, const float* input, float* output, T b0, T b1, T b2, T a1, T a2, T &s1, T &s2) {
+	for(int i = 0; i < blockSize; i++) {
+		T x = input[i];
+		T y = b0*x+s1;
+		s1 = b1*x-a1*y+s2;
+		s2 = b2*x-a2*y;
+		output[i] = (float)y;
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+
+//One step of the recursion for every lane in the register.
+inline __m128 biquadBankStep(__m128 x, __m128 b0, __m128 b1, __m128 b2, __m128 a1, __m128 a2, __m128 &s1, __m128 &s2) {
+	__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+	s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+	s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+	return y;
+}
+
+void BiquadBank::processFloat(int blockSize, float** inputs, float** outputs) {
+	int groups = lanes/4*4;
+	int samples = blockSize/4*4;
+	for(int l = 0; l < groups; l += 4) {
+		__m128 vb0 = _mm_loadu_ps(&b0f[l]), vb1 = _mm_loadu_ps(&b1f[l]), vb2 = _mm_loadu_ps(&b2f[l]);
+		__m128 va1 = _mm_loadu_ps(&a1f[l]), va2 = _mm_loadu_ps(&a2f[l]);
+		__m128 vs1 = _mm_loadu_ps(&s1f[l]), vs2 = _mm_loadu_ps(&s2f[l]);
+		float** in = inputs+l;
+		float** out = outputs+l;
+		for(int i = 0; i < samples; i += 4) {
+			//Load 4 samples from each of 4 lanes; transposing gives 4 consecutive samples across all lanes.
+			__m128 x0 = _mm_loadu_ps(in[0]+i), x1 = _mm_loadu_ps(in[1]+i), x2 = _mm_loadu_ps(in[2]+i), x3 = _mm_loadu_ps(in[3]+i);
+			_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+			x0 = biquadBankStep(x0, vb0, vb1, vb2, va1, va2, vs1, vs2);
+			x1 = biquadBankStep(x1, vb0, vb1, vb2, va1, va2, vs1, vs2);
+			x2 = biquadBankStep(x2, vb0, vb1, vb2, va1, va2, vs1, vs2);
+			x3 = biquadBankStep(x3, vb0, vb1, vb2, va1, va2, vs1, vs2);
+			_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+			_mm_storeu_ps(out[0]+i, x0);
+			_mm_storeu_ps(out[1]+i, x1);
+			_mm_storeu_ps(out[2]+i, x2);
+			_mm_storeu_ps(out[3]+i, x3);
+		}
+		_mm_storeu_ps(&s1f[l], vs1);
+		_mm_storeu_ps(&s2f[l], vs2);
+		if(samples < blockSize) for(int j = l; j < l+4; j++) biquadBankLaneSimple(blockSize-samples, inputs[j]+samples, outputs[j]+samples, b0f[j], b1f[j], b2f[j], a1f[j], a2f[j], s1f[j], s2f[j]);
+	}
+	for(int j = groups; j < lanes; j++) biquadBankLaneSimple(blockSize, inputs[j], outputs[j], b0f[j], b1f[j], b2f[j], a1f[j], a2f[j], s1f[j], s2f[j]);
+}
+
+void BiquadBank::processDouble(int blockSize, float** inputs, float** outputs) {
+	int groups = lanes/2*2;
+	for(int l = 0; l < groups; l += 2) {
+		__m128d vb0 = _mm_loadu_pd(&b0[l]), vb1 = _mm_loadu_pd(&b1[l]), vb2 = _mm_loadu_pd(&b2[l]);
+		__m128d va1 = _mm_loadu_pd(&a1[l]), va2 = _mm_loadu_pd(&a2[l]);
+		__m128d vs1 = _mm_loadu_pd(&s1[l]), vs2 = _mm_loadu_pd(&s2[l]);
+		float *in0 = inputs[l], *in1 = inputs[l+1], *out0 = outputs[l], *out1 = outputs[l+1];
+		for(int i = 0; i < blockSize; i++) {
+			__m128d x = _mm_set_pd(in1[i], in0[i]);
+			__m128d y = _mm_add_pd(_mm_mul_pd(vb0, x), vs1);
+			vs1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(vb1, x), _mm_mul_pd(va1, y)), vs2);
+			vs2 = _mm_sub_pd(_mm_mul_pd(vb2, x), _mm_mul_pd(va2, y));
+			out0[i] = (float)_mm_cvtsd_f64(y);
+			out1[i] = (float)_mm_cvtsd_f64(_mm_unpackhi_pd(y, y));
+		}
+		_mm_storeu_pd(&s1[l], vs1);
+		_mm_storeu_pd(&s2[l], vs2);
+	}
+	for(int j = groups; j < lanes; j++) biquadBankLaneSimple(blockSize, inputs[j], outputs[j], b0[j], b1[j], b2[j], a1[j], a2[j], s1[j], s2[j]);
+}
+
+#else
+
+void BiquadBank::processFloat(int blockSize, float** inputs, float** outputs) {
+	for(int j = 0; j < lanes; j++) biquadBankLaneSimple(blockSize, inputs[j], outputs[j], b0f[j], b1f[j], b2f[j], a1f[j], a2f[j], s1f[j], s2f[j]);
+}
+
+void BiquadBank::processDouble(int blockSize, float** inputs, float** outputs) {
+	for(int j = 0; j < lanes; j++) biquadBankLaneSimple(blockSize, inputs[j], outputs[j], b0[j], b1[j], b2[j], a1[j], a2[j], s1[j], s2[j]);
+}
+
+#endif
+
+}
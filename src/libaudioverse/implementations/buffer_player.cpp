@@ -0,0 +1,355 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <libaudioverse/implementations/buffer_player.hpp>
+#include <libaudioverse/private/buffer.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <math.h>
+#include <algorithm>
+#include <memory>
+#include <mmintrin.h>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace libaudioverse_implementation {
+
+//The widest interpolator, the sinc, needs this many samples either side of the one before the output.
+const int buffer_player_taps_before = 3;
+const int buffer_player_taps_after = 4;
+const int buffer_player_sinc_taps = buffer_player_taps_before+buffer_player_taps_after+1;
+const int buffer_player_sinc_phases = 256;
+
+/**Rows of 8 taps for fractional positions 0, 1/256, ..., 1; about 8KB, so it stays in cache.
+Blackman-windowed sinc with the cutoff a little under nyquist, each row normalized to unity gain at DC.*/
+const float* bufferPlayerSincTable() {
+	static float* table = [] () {
+		float* t = new float[(buffer_player_sinc_phases+1)*buffer_player_sinc_taps];
+		const double cutoff = 0.9;
+		for(int p = 0; p <= buffer_player_sinc_phases; p++) {
+			double frac = (double)p/buffer_player_sinc_phases, sum = 0.0;
+			float* row = t+p*buffer_player_sinc_taps;
+			for(int j = 0; j < buffer_player_sinc_taps; j++) {
+				double d = j-buffer_player_taps_before-frac;
+				double x = d/(buffer_player_taps_after);
+				double window = fabs(x) >= 1.0 ? 0.0 : 0.42+0.5*cos(PI*x)+0.08*cos(2*PI*x);
+				double sinc = d == 0.0 ? 1.0 : sin(PI*cutoff*d)/(PI*cutoff*d);
+				row[j] = (float)(sinc*window);
+				sum += row[j];
+			}
+			for(int j = 0; j < buffer_player_sinc_taps; j++) row[j] = (float)(row[j]/sum);
+		}
+		return t;
+	}();
+	return table;
+}
+
+inline int sincPhase(float fraction) {
+	return (int)(fraction*buffer_player_sinc_phases+0.5f);
+}
+
+//Interpolators.  Output i interpolates between window[indices[i]] and window[indices[i]+1].
+//If add is true, they mix into output instead of replacing it.
+
+void linearInterpolateSimple(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	for(int i = 0; i < count; i++) {
+		float a = window[indices[i]], b = window[indices[i]+1];
+		float o = a+fractions[i]*(b-a);
+		output[i] = add ? output[i]+o : o;
+	}
+}
+
+//Catmull-Rom.
+void cubicInterpolateSimple(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	for(int i = 0; i < count; i++) {
+		const float* y = window+indices[i]-1;
+		float t = fractions[i];
+		float c1 = 0.5f*(y[2]-y[0]);
+		float c2 = y[0]-2.5f*y[1]+2.0f*y[2]-0.5f*y[3];
+		float c3 = 0.5f*(y[3]-y[0])+1.5f*(y[1]-y[2]);
+		float o = ((c3*t+c2)*t+c1)*t+y[1];
+		output[i] = add ? output[i]+o : o;
+	}
+}
+
+void sincInterpolateSimple(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	const float* table = bufferPlayerSincTable();
+	for(int i = 0; i < count; i++) {
+		const float* y = window+indices[i]-buffer_player_taps_before;
+		const float* row = table+sincPhase(fractions[i])*buffer_player_sinc_taps;
+		float sum = 0.0f;
+		for(int j = 0; j < buffer_player_sinc_taps; j++) sum += y[j]*row[j];
+		output[i] = add ? output[i]+sum : sum;
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+void linearInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	int neededLength = (count/4)*4;
+	for(int i = 0; i < neededLength; i += 4) {
+		const int* idx = indices+i;
+		__m128 a = _mm_set_ps(window[idx[3]], window[idx[2]], window[idx[1]], window[idx[0]]);
+		__m128 b = _mm_set_ps(window[idx[3]+1], window[idx[2]+1], window[idx[1]+1], window[idx[0]+1]);
+		__m128 t = _mm_loadu_ps(fractions+i);
+		__m128 o = _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+		if(add) o = _mm_add_ps(o, _mm_loadu_ps(output+i));
+		_mm_storeu_ps(output+i, o);
+	}
+	linearInterpolateSimple(count-neededLength, window, indices+neededLength, fractions+neededLength, output+neededLength, add);
+}
+
+void cubicInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	int neededLength = (count/4)*4;
+	__m128 half = _mm_set1_ps(0.5f), oneAndHalf = _mm_set1_ps(1.5f), two = _mm_set1_ps(2.0f), twoAndHalf = _mm_set1_ps(2.5f);
+	for(int i = 0; i < neededLength; i += 4) {
+		//Each load is the 4 samples around one output; transposing gives y0 through y3 for all 4 outputs.
+		__m128 y0 = _mm_loadu_ps(window+indices[i]-1);
+		__m128 y1 = _mm_loadu_ps(window+indices[i+1]-1);
+		__m128 y2 = _mm_loadu_ps(window+indices[i+2]-1);
+		__m128 y3 = _mm_loadu_ps(window+indices[i+3]-1);
+		_MM_TRANSPOSE4_PS(y0, y1, y2, y3);
+		__m128 t = _mm_loadu_ps(fractions+i);
+		__m128 c1 = _mm_mul_ps(half, _mm_sub_ps(y2, y0));
+		__m128 c2 = _mm_sub_ps(_mm_add_ps(y0, _mm_mul_ps(two, y2)), _mm_add_ps(_mm_mul_ps(twoAndHalf, y1), _mm_mul_ps(half, y3)));
+		__m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(y3, y0)), _mm_mul_ps(oneAndHalf, _mm_sub_ps(y1, y2)));
+		__m128 o = _mm_add_ps(_mm_mul_ps(c3, t), c2);
+		o = _mm_add_ps(_mm_mul_ps(o, t), c1);
+		o = _mm_add_ps(_mm_mul_ps(o, t), y1);
+		if(add) o = _mm_add_ps(o, _mm_loadu_ps(output+i));
+		_mm_storeu_ps(output+i, o);
+	}
+	cubicInterpolateSimple(count-neededLength, window, indices+neededLength, fractions+neededLength, output+neededLength, add);
+}
+
+inline __m128 sincTapProducts(const float* window, int index, float fraction, const float* table) {
+	const float* y = window+index-buffer_player_taps_before;
+	const float* row = table+sincPhase(fraction)*buffer_player_sinc_taps;
+	return _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(y), _mm_loadu_ps(row)), _mm_mul_ps(_mm_loadu_ps(y+4), _mm_loadu_ps(row+4)));
+}
+
+void sincInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	const float* table = bufferPlayerSincTable();
+	int neededLength = (count/4)*4;
+	for(int i = 0; i < neededLength; i += 4) {
+		__m128 p0 = sincTapProducts(window, indices[i], fractions[i], table);
+		__m128 p1 = sincTapProducts(window, indices[i+1], fractions[i+1], table);
+		__m128 p2 = sincTapProducts(window, indices[i+2], fractions[i+2], table);
+		__m128 p3 = sincTapProducts(window, indices[i+3], fractions[i+3], table);
+		//Transposing turns 4 horizontal sums into 3 vertical adds.
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		__m128 o = _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3));
+		if(add) o = _mm_add_ps(o, _mm_loadu_ps(output+i));
+		_mm_storeu_ps(output+i, o);
+	}
+	sincInterpolateSimple(count-neededLength, window, indices+neededLength, fractions+neededLength, output+neededLength, add);
+}
+
+#else
+void linearInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	linearInterpolateSimple(count, window, indices, fractions, output, add);
+}
+
+void cubicInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	cubicInterpolateSimple(count, window, indices, fractions, output, add);
+}
+
+void sincInterpolate(int count, const float* window, const int* indices, const float* fractions, float* output, bool add) {
+	sincInterpolateSimple(count, window, indices, fractions, output, add);
+}
+#endif
+
+BufferPlayer::BufferPlayer(int blockSize, float sr): block_size(blockSize), sr(sr) {
+	indices = allocArray<int>(blockSize);
+	fractions = allocArray<float>(blockSize);
+	//Enough for rates up to 2 in one piece; see processInterpolated.
+	window_length = 2*blockSize+buffer_player_taps_before+buffer_player_taps_after+1;
+	window = allocArray<float>(window_length);
+}
+
+BufferPlayer::~BufferPlayer() {
+	if(buffer) buffer->decrementUseCount();
+	freeArray(indices);
+	freeArray(fractions);
+	freeArray(window);
+}
+
+//Zeroes, unless mixing, in which case there's nothing to do.
+inline void bufferPlayerSilence(float* output, int count, bool add) {
+	if(add == false) std::fill(output, output+count, 0.0f);
+}
+
+void BufferPlayer::process(int channels, float** outputs, bool add, int start) {
+	int count = block_size-start;
+	bool silent = buffer == nullptr || buffer_frames == 0 || (is_looping == false && position >= buffer_frames);
+	if(silent) {
+		for(int i = 0; i < channels; i++) bufferPlayerSilence(outputs[i]+start, count, add);
+		return;
+	}
+	if(rate == 1.0 && position == floor(position)) processCopy(channels, outputs, add, start);
+	else processInterpolated(channels, outputs, add, start);
+	for(int i = buffer_channels; i < channels; i++) bufferPlayerSilence(outputs[i]+start, count, add);
+}
+
+void BufferPlayer::processCopy(int channels, float** outputs, bool add, int start) {
+	int usedChannels = std::min(channels, buffer_channels);
+	int frame = (int)position, written = start;
+	while(written < block_size) {
+		if(frame >= buffer_frames) {
+			if(is_looping == false) break;
+			frame = 0;
+		}
+		int count = std::min(block_size-written, buffer_frames-frame);
+		for(int c = 0; c < usedChannels; c++) {
+			float* destination = outputs[c]+written;
+			float* source = buffer->getPointer(frame, c);
+			//Compressed storage has to be decoded somewhere first if mixing.  The window is always at least a block.
+			if(source == nullptr && add) {
+				buffer->readFrames(frame, c, count, window);
+				source = window;
+			}
+			if(source == nullptr) buffer->readFrames(frame, c, count, destination);
+			else if(add) additionKernel(count, source, destination, destination);
+			else std::copy(source, source+count, destination);
+		}
+		frame += count;
+		written += count;
+		if(frame >= buffer_frames) ended_count++;
+	}
+	for(int c = 0; c < usedChannels; c++) bufferPlayerSilence(outputs[c]+written, block_size-written, add);
+	if(is_looping && frame >= buffer_frames) frame = 0;
+	position = frame;
+}
+
+void BufferPlayer::processInterpolated(int channels, float** outputs, bool add, int start) {
+	//The window is allocated once, so fast rates are done a piece of the block at a time rather than growing it here.
+	//Each piece needs a span of at most window_length; the window always holds at least 2 blocks, so pieces are never empty.
+	int maxCount = block_size;
+	if(rate > 1.0) maxCount = (int)std::min<double>(block_size, (window_length-buffer_player_taps_before-buffer_player_taps_after-1)/rate+1);
+	while(start < block_size) {
+		if(is_looping == false && position >= buffer_frames) {
+			int usedChannels = std::min(channels, buffer_channels);
+			for(int c = 0; c < usedChannels; c++) bufferPlayerSilence(outputs[c]+start, block_size-start, add);
+			break;
+		}
+		int count = std::min(block_size-start, maxCount);
+		processInterpolatedRange(channels, outputs, add, start, count);
+		start += count;
+	}
+}
+
+void BufferPlayer::processInterpolatedRange(int channels, float** outputs, bool add, int start, int count) {
+	int usedChannels = std::min(channels, buffer_channels);
+	int firstFrame = (int)floor(position);
+	double firstFraction = position-firstFrame;
+	//Without looping, outputs at or past the end are silent.
+	int valid = count;
+	if(is_looping == false && rate > 0.0) valid = std::min(count, (int)ceil((buffer_frames-position)/rate));
+	int windowStart = firstFrame-buffer_player_taps_before;
+	int span = (int)(firstFraction+(count-1)*rate)+1+buffer_player_taps_before+buffer_player_taps_after;
+	for(int i = 0; i < valid; i++) {
+		double relative = firstFraction+i*rate;
+		int whole = (int)relative;
+		indices[i] = whole+buffer_player_taps_before;
+		fractions[i] = (float)(relative-whole);
+	}
+	for(int c = 0; c < usedChannels; c++) {
+		float* output = outputs[c]+start;
+		readWindow(c, windowStart, span, window);
+		switch(interpolation) {
+			case Lav_INTERPOLATION_TYPE_CUBIC: cubicInterpolate(valid, window, indices, fractions, output, add); break;
+			case Lav_INTERPOLATION_TYPE_SINC: sincInterpolate(valid, window, indices, fractions, output, add); break;
+			default: linearInterpolate(valid, window, indices, fractions, output, add); break;
+		}
+		bufferPlayerSilence(output+valid, count-valid, add);
+	}
+	position += count*rate;
+	if(is_looping) {
+		while(position >= buffer_frames) {
+			position -= buffer_frames;
+			ended_count++;
+		}
+	}
+	else if(position >= buffer_frames) {
+		position = buffer_frames;
+		ended_count++;
+	}
+}
+
+void BufferPlayer::readWindow(int channel, int start, int count, float* destination) {
+	int i = 0;
+	while(i < count) {
+		int source = start+i;
+		if(is_looping) {
+			source %= buffer_frames;
+			if(source < 0) source += buffer_frames;
+		}
+		else if(source < 0 || source >= buffer_frames) {
+			int zeros = source < 0 ? std::min(count-i, -source) : count-i;
+			std::fill(destination+i, destination+i+zeros, 0.0f);
+			i += zeros;
+			continue;
+		}
+		int got = std::min(count-i, buffer_frames-source);
+		buffer->readFrames(source, channel, got, destination+i);
+		i += got;
+	}
+}
+
+void BufferPlayer::setBuffer(std::shared_ptr<Buffer> buffer) {
+	if(buffer) buffer->incrementUseCount();
+	if(this->buffer) this->buffer->decrementUseCount();
+	this->buffer = buffer;
+	buffer_frames = buffer ? buffer->getLength() : 0;
+	buffer_channels = buffer ? buffer->getChannels() : 0;
+	position = 0.0;
+}
+
+std::shared_ptr<Buffer> BufferPlayer::getBuffer() {
+	return buffer;
+}
+
+int BufferPlayer::getEndedCount() {
+	return ended_count;
+}
+
+void BufferPlayer::resetEndedCount() {
+	ended_count = 0;
+}
+
+bool BufferPlayer::getIsLooping() {
+	return is_looping;
+}
+
+void BufferPlayer::setIsLooping(bool looping) {
+	is_looping = looping;
+}
+
+double BufferPlayer::getRate() {
+	return rate;
+}
+
+void BufferPlayer::setRate(double rate) {
+	this->rate = rate;
+}
+
+double BufferPlayer::getPosition() {
+	return position/sr;
+}
+
+void BufferPlayer::setPosition(double position) {
+	this->position = std::min<double>(std::max(0.0, position*sr), buffer_frames);
+}
+
+int BufferPlayer::getInterpolation() {
+	return interpolation;
+}
+
+void BufferPlayer::setInterpolation(int interpolation) {
+	this->interpolation = interpolation;
+}
+
+}
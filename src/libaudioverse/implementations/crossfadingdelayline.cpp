@@ -3,6 +3,7 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/implementations/delayline.hpp>
+#include <libaudioverse/private/kernels.hpp>
 #include <algorithm>
 #include <functional>
 #include <math.h>
@@ -62,8 +63,17 @@ void CrossfadingDelayLine::processBuffer(int length, float* input, float* output
 		weight2=0.0f;
 		delay = new_delay;
 	}
-	//We might have a bit more.
-	for(int i = cf; i < length; i++) {
+	//We might have a bit more, at a fixed delay.
+	//Writing the input first and then copying out is safe in place, so long as the write doesn't lap samples we haven't read yet.
+	int i = cf;
+	while(i < length) {
+		int chunk = std::min<int>(length-i, line.getLength()-1-delay);
+		if(chunk <= 0) break;
+		line.writeBlock(chunk, input+i);
+		line.readBlock(delay+chunk, chunk, output+i);
+		i += chunk;
+	}
+	for(; i < length; i++) {
 		sample= input[i];
 		output[i] = line.read(delay);
 		line.advance(sample);
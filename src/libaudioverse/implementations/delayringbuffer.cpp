@@ -3,6 +3,8 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/implementations/delayline.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <string.h>
 #include <algorithm>
 #include <functional>
 #include <math.h>
@@ -42,6 +44,41 @@ void DelayRingbuffer::add(unsigned int index, float value) {
 	buffer[(write_head-index) & mask] += value;
 }
 
+void DelayRingbuffer::readBlock(unsigned int offset, int length, float* output) {
+	unsigned int start = (write_head-offset) & mask;
+	int first = std::min<int>(length, buffer_length-start);
+	std::copy(buffer+start, buffer+start+first, output);
+	std::copy(buffer, buffer+length-first, output+first);
+}
+
+void DelayRingbuffer::mixBlock(unsigned int offset, int length, float weight, float* output) {
+	unsigned int start = (write_head-offset) & mask;
+	int first = std::min<int>(length, buffer_length-start);
+	multiplicationAdditionKernel(first, weight, buffer+start, output, output);
+	multiplicationAdditionKernel(length-first, weight, buffer, output+first, output+first);
+}
+
+void DelayRingbuffer::writeBlock(int length, const float* input) {
+	//Anything older than the last buffer_length samples would be overwritten anyway.
+	if(length > (int)buffer_length) {
+		write_head += length-buffer_length;
+		input += length-buffer_length;
+		length = buffer_length;
+	}
+	unsigned int start = (write_head+1) & mask;
+	int first = std::min<int>(length, buffer_length-start);
+	std::copy(input, input+first, buffer+start);
+	std::copy(input+first, input+length, buffer);
+	write_head += length;
+}
+
+void DelayRingbuffer::addBlock(unsigned int offset, int length, const float* input) {
+	unsigned int start = (write_head-offset) & mask;
+	int first = std::min<int>(length, buffer_length-start);
+	additionKernel(first, buffer+start, (float*)input, buffer+start);
+	additionKernel(length-first, buffer, (float*)input+first, buffer);
+}
+
 void DelayRingbuffer::reset() {
 	memset(buffer, 0, sizeof(float)*buffer_length);
 }
@@ -3,6 +3,7 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/implementations/delayline.hpp>
+#include <libaudioverse/private/kernels.hpp>
 #include <algorithm>
 #include <functional>
 #include <math.h>
@@ -53,6 +54,38 @@ float DoppleringDelayLine::tick(float sample) {
 	return retval;
 }
 
+void DoppleringDelayLine::processBuffer(int length, float* input, float* output) {
+	int i = 0;
+	float sample;
+	//While the delay is moving, go sample by sample.
+	for(; i < length && counter; i++) {
+		sample = input[i];
+		output[i] = computeSample();
+		advance(sample);
+	}
+	if(i == length) return;
+	//The same arithmetic as computeSample, so this is identical to ticking.
+	float w1 = delay-floorf(delay);
+	float w2 = 1-w1;
+	int i1 = std::min((int)delay, max_delay);
+	int i2 = std::min((int)delay+1, max_delay);
+	//See CrossfadingDelayLine::processBuffer.
+	while(i < length) {
+		int chunk = std::min<int>(length-i, line.getLength()-1-i2);
+		if(chunk <= 0) break;
+		line.writeBlock(chunk, input+i);
+		line.readBlock(i2+chunk, chunk, output+i);
+		scalarMultiplicationKernel(chunk, w2, output+i, output+i);
+		line.mixBlock(i1+chunk, chunk, w1, output+i);
+		i += chunk;
+	}
+	for(; i < length; i++) {
+		sample = input[i];
+		output[i] = computeSample();
+		line.advance(sample);
+	}
+}
+
 float DoppleringDelayLine::computeSample() {
 	float w1 = delay-floorf(delay);
 	float w2 = 1-w1;
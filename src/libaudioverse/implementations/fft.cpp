@@ -0,0 +1,193 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/implementations/fft.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <math.h>
+#include <kiss_fftr.h>
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+#include <xmmintrin.h>
+#endif
+
+namespace libaudioverse_implementation {
+
+//Below this, kissfft is as fast or faster; the first two stages of our transform are scalar.
+const int simd_fft_minimum_size = 128;
+
+static bool isPowerOfTwo(int n) {
+	return n > 0 && (n&(n-1)) == 0;
+}
+
+RealFft::RealFft(int size): size(size) {
+	half_size = size/2;
+	#if defined(LIBAUDIOVERSE_USE_SIMD_FFT)
+	use_simd = size >= simd_fft_minimum_size && isPowerOfTwo(size);
+	#endif
+	if(use_simd == false) {
+		fft = kiss_fftr_alloc(size, 0, nullptr, nullptr);
+		ifft = kiss_fftr_alloc(size, 1, nullptr, nullptr);
+		return;
+	}
+	re = allocArray<float>(half_size);
+	im = allocArray<float>(half_size);
+	work_re = allocArray<float>(half_size);
+	work_im = allocArray<float>(half_size);
+	twiddle_re = allocArray<float>(half_size/2);
+	twiddle_im = allocArray<float>(half_size/2);
+	for(int i = 0; i < half_size/2; i++) {
+		double angle = -2*PI*i/half_size;
+		twiddle_re[i] = (float)cos(angle);
+		twiddle_im[i] = (float)sin(angle);
+	}
+	split_re = allocArray<float>(half_size);
+	split_im = allocArray<float>(half_size);
+	for(int i = 0; i < half_size; i++) {
+		double angle = -2*PI*i/size;
+		split_re[i] = (float)cos(angle);
+		split_im[i] = (float)sin(angle);
+	}
+}
+
+RealFft::~RealFft() {
+	if(fft) kiss_fftr_free(fft);
+	if(ifft) kiss_fftr_free(ifft);
+	for(float* i: {re, im, work_re, work_im, twiddle_re, twiddle_im, split_re, split_im}) {
+		if(i) freeArray(i);
+	}
+}
+
+int RealFft::getSize() {
+	return size;
+}
+
+int RealFft::getBinCount() {
+	return half_size+1;
+}
+
+bool RealFft::isUsingSimdBackend() {
+	return use_simd;
+}
+
+/**One column of Stockham butterflies.
+a and b are the two inputs, y0 and y1 the outputs; all are s long.  y1 gets (a-b)*w.*/
+static void stockhamButterflySimple(int s, float wr, float wi, float* ar, float* ai, float* br, float* bi, float* y0r, float* y0i, float* y1r, float* y1i) {
+	for(int q = 0; q < s; q++) {
+		float dr = ar[q]-br[q], di = ai[q]-bi[q];
+		y0r[q] = ar[q]+br[q];
+		y0i[q] = ai[q]+bi[q];
+		y1r[q] = dr*wr-di*wi;
+		y1i[q] = dr*wi+di*wr;
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+static void stockhamButterfly(int s, float wr, float wi, float* ar, float* ai, float* br, float* bi, float* y0r, float* y0i, float* y1r, float* y1i) {
+	if(s < 4) {
+		stockhamButterflySimple(s, wr, wi, ar, ai, br, bi, y0r, y0i, y1r, y1i);
+		return;
+	}
+	//s is a power of two, so there is never a tail.
+	__m128 wrr = _mm_set1_ps(wr), wir = _mm_set1_ps(wi);
+	for(int q = 0; q < s; q+=4) {
+		__m128 arr = _mm_loadu_ps(ar+q), air = _mm_loadu_ps(ai+q);
+		__m128 brr = _mm_loadu_ps(br+q), bir = _mm_loadu_ps(bi+q);
+		_mm_storeu_ps(y0r+q, _mm_add_ps(arr, brr));
+		_mm_storeu_ps(y0i+q, _mm_add_ps(air, bir));
+		__m128 dr = _mm_sub_ps(arr, brr), di = _mm_sub_ps(air, bir);
+		_mm_storeu_ps(y1r+q, _mm_sub_ps(_mm_mul_ps(dr, wrr), _mm_mul_ps(di, wir)));
+		_mm_storeu_ps(y1i+q, _mm_add_ps(_mm_mul_ps(dr, wir), _mm_mul_ps(di, wrr)));
+	}
+}
+#else
+static void stockhamButterfly(int s, float wr, float wi, float* ar, float* ai, float* br, float* bi, float* y0r, float* y0i, float* y1r, float* y1i) {
+	stockhamButterflySimple(s, wr, wi, ar, ai, br, bi, y0r, y0i, y1r, y1i);
+}
+#endif
+
+void RealFft::complexFft(bool isInverse, float** outRe, float** outIm) {
+	float *xr = re, *xi = im, *yr = work_re, *yi = work_im;
+	float sign = isInverse ? -1.0f : 1.0f;
+	//n is the length of the sub-transforms at this stage and s their count.
+	//Stockham autosort: the output ends up in natural order, so no bit reversal.
+	int n = half_size, s = 1;
+	while(n > 1) {
+		int m = n/2;
+		for(int p = 0; p < m; p++) {
+			stockhamButterfly(s, twiddle_re[p*s], sign*twiddle_im[p*s],
+			xr+s*p, xi+s*p, xr+s*(p+m), xi+s*(p+m),
+			yr+2*s*p, yi+2*s*p, yr+2*s*p+s, yi+2*s*p+s);
+		}
+		n = m;
+		s *= 2;
+		std::swap(xr, yr);
+		std::swap(xi, yi);
+	}
+	*outRe = xr;
+	*outIm = xi;
+}
+
+void RealFft::forward(float* input, kiss_fft_cpx* output) {
+	if(use_simd == false) {
+		kiss_fftr(fft, input, output);
+		return;
+	}
+	//Pack the even samples as the real part and the odd as the imaginary part, and take a half-size complex fft.
+	for(int i = 0; i < half_size; i++) {
+		re[i] = input[2*i];
+		im[i] = input[2*i+1];
+	}
+	float *zr, *zi;
+	complexFft(false, &zr, &zi);
+	//Split the result into the ffts of the even and odd samples, and recombine: X[k] = Fe[k]+W^k*Fo[k].
+	output[0].r = zr[0]+zi[0];
+	output[0].i = 0.0f;
+	output[half_size].r = zr[0]-zi[0];
+	output[half_size].i = 0.0f;
+	for(int k = 1; k < half_size; k++) {
+		int j = half_size-k;
+		float er = 0.5f*(zr[k]+zr[j]), ei = 0.5f*(zi[k]-zi[j]);
+		float or_ = 0.5f*(zi[k]+zi[j]), oi = -0.5f*(zr[k]-zr[j]);
+		output[k].r = er+split_re[k]*or_-split_im[k]*oi;
+		output[k].i = ei+split_re[k]*oi+split_im[k]*or_;
+	}
+}
+
+void RealFft::inverse(kiss_fft_cpx* input, float* output) {
+	if(use_simd == false) {
+		kiss_fftri(ifft, input, output);
+		return;
+	}
+	//Undo the split, giving twice the half-size fft; the factor of two makes the scaling match kiss_fftri.
+	for(int k = 0; k < half_size; k++) {
+		int j = half_size-k;
+		float er = input[k].r+input[j].r, ei = input[k].i-input[j].i;
+		float dr = input[k].r-input[j].r, di = input[k].i+input[j].i;
+		//Multiply by the conjugate twiddle.
+		float or_ = dr*split_re[k]+di*split_im[k];
+		float oi = di*split_re[k]-dr*split_im[k];
+		re[k] = er-oi;
+		im[k] = ei+or_;
+	}
+	float *zr, *zi;
+	complexFft(true, &zr, &zi);
+	for(int i = 0; i < half_size; i++) {
+		output[2*i] = zr[i];
+		output[2*i+1] = zi[i];
+	}
+}
+
+int realFftNextFastSize(int n) {
+	int kissSize = kiss_fftr_next_fast_size_real(n);
+	#if defined(LIBAUDIOVERSE_USE_SIMD_FFT)
+	int powerOfTwo = simd_fft_minimum_size;
+	while(powerOfTwo < n) powerOfTwo *= 2;
+	//Trading a slightly longer transform for SIMD is worth it; doubling the length isn't.
+	if(powerOfTwo <= kissSize+kissSize/4) return powerOfTwo;
+	#endif
+	return kissSize;
+}
+
+}
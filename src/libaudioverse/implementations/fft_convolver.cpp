@@ -4,7 +4,10 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/private/kernels.hpp>
 #include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <libaudioverse/libaudioverse.h>
 #include <libaudioverse/implementations/convolvers.hpp>
+#include <libaudioverse/implementations/fft.hpp>
 #include <algorithm>
 #include <functional>
 #include <math.h>
@@ -12,6 +15,40 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 
 namespace libaudioverse_implementation {
 
+ResponseSpectrum::ResponseSpectrum(int length, float* response, int blockSize): length(length), block_size(blockSize) {
+	fft_size = realFftNextFastSize(block_size+length);
+	bins = allocArray<kiss_fft_cpx>(fft_size/2+1);
+	float* workspace = allocArray<float>(fft_size);
+	std::copy(response, response+length, workspace);
+	RealFft fft(fft_size);
+	fft.forward(workspace, bins);
+	freeArray(workspace);
+}
+
+ResponseSpectrum::~ResponseSpectrum() {
+	freeArray(bins);
+}
+
+int ResponseSpectrum::getLength() {
+	return length;
+}
+
+int ResponseSpectrum::getBlockSize() {
+	return block_size;
+}
+
+int ResponseSpectrum::getFftSize() {
+	return fft_size;
+}
+
+int ResponseSpectrum::getBinCount() {
+	return fft_size/2+1;
+}
+
+const kiss_fft_cpx* ResponseSpectrum::getBins() {
+	return bins;
+}
+
 FftConvolver::FftConvolver(int blockSize): block_size(blockSize) {
 	float defaultResponse=1;
 	setResponse(1, &defaultResponse);
@@ -20,14 +57,19 @@ FftConvolver::FftConvolver(int blockSize): block_size(blockSize) {
 FftConvolver::~FftConvolver() {
 	if(workspace) freeArray(workspace);
 	if(tail) freeArray(tail);
-	if(fft) kiss_fftr_free(fft);
-	if(ifft) kiss_fftr_free(ifft);
+	if(block_fft) freeArray(block_fft);
+	if(real_fft) delete real_fft;
 }
 
 void FftConvolver::setResponse(int length, float* newResponse) {
-	int neededLength= kiss_fftr_next_fast_size_real	(block_size+length);
+	setResponseSpectrum(std::make_shared<ResponseSpectrum>(length, newResponse, block_size));
+}
+
+void FftConvolver::setResponseSpectrum(std::shared_ptr<ResponseSpectrum> spectrum) {
+	if(spectrum->getBlockSize() != block_size) ERROR(Lav_ERROR_RANGE, "Response spectrum was computed for a different block size.");
+	int neededLength = spectrum->getFftSize();
 	int newTailSize=neededLength-block_size;
-	if(neededLength !=fft_size || tail_size !=newTailSize) {
+	if(neededLength != workspace_size) {
 		if(workspace) freeArray(workspace);
 		workspace=allocArray<float>(neededLength);
 		if(tail) freeArray(tail);
@@ -35,19 +77,12 @@ void FftConvolver::setResponse(int length, float* newResponse) {
 		fft_size=neededLength/2+1;
 		workspace_size=neededLength;
 		tail_size=newTailSize;
-		if(fft) kiss_fftr_free(fft);
-		fft = kiss_fftr_alloc(workspace_size, 0, nullptr, nullptr);
-		if(ifft) kiss_fftr_free(ifft);
-		ifft=kiss_fftr_alloc(workspace_size, 1, nullptr, nullptr);
-		if(response_fft) freeArray(response_fft);
-		response_fft=allocArray<kiss_fft_cpx>(fft_size);
+		if(real_fft) delete real_fft;
+		real_fft = new RealFft(workspace_size);
 		if(block_fft) freeArray(block_fft);
 		block_fft=allocArray<kiss_fft_cpx>(fft_size);
 	}
-	memset(workspace, 0, sizeof(float)*workspace_size);
-	//Store the fft of the response.
-	std::copy(newResponse, newResponse+length, workspace);
-	kiss_fftr(fft, workspace, response_fft);
+	response_spectrum = spectrum;
 }
 
 void FftConvolver::convolve(float* input, float* output) {
@@ -63,20 +98,21 @@ kiss_fft_cpx *FftConvolver::getFft(float* input) {
 	std::fill(workspace+block_size, workspace+workspace_size, 0.0);
 	//Copy input to the workspace, and take its fft.
 	std::copy(input, input+block_size, workspace);
-	kiss_fftr(fft, workspace, block_fft);
+	real_fft->forward(workspace, block_fft);
 	return block_fft;
 }
 
 void FftConvolver::convolveFft(kiss_fft_cpx *fft, float* output) {
 	//Do a complex multiply.
 	//Note that the first line is subtraction because of the i^2.
+	const kiss_fft_cpx* response_fft = response_spectrum->getBins();
 	for(int i=0; i < fft_size; i++) {
 		kiss_fft_cpx tmp;
 		tmp.r = fft[i].r*response_fft[i].r-fft[i].i*response_fft[i].i;
 		tmp.i = fft[i].r*response_fft[i].i+fft[i].i*response_fft[i].r;
 		block_fft[i] = tmp;
 	}
-	kiss_fftri(ifft, block_fft, workspace);
+	real_fft->inverse(block_fft, workspace);
 	//Add the tail over the block.
 	additionKernel(tail_size, tail, workspace, workspace);
 	//Downscale the first part, our output.
@@ -0,0 +1,118 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/private/kernels.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/implementations/convolvers.hpp>
+#include <libaudioverse/implementations/fft.hpp>
+#include <algorithm>
+#include <vector>
+#include <kiss_fftr.h>
+
+namespace libaudioverse_implementation {
+
+FftMatrixConvolver::FftMatrixConvolver(int blockSize, int inputCount, int outputCount): block_size(blockSize), input_count(inputCount), output_count(outputCount) {
+	responses.resize(input_count*output_count);
+	response_ffts.resize(input_count*output_count, nullptr);
+	input_ffts.resize(input_count, nullptr);
+	tails.resize(output_count, nullptr);
+	float defaultResponse = 1.0f;
+	for(int i = 0; i < std::min(input_count, output_count); i++) setResponse(i, i, 1, &defaultResponse);
+}
+
+FftMatrixConvolver::~FftMatrixConvolver() {
+	for(auto i: response_ffts) if(i) freeArray(i);
+	for(auto i: input_ffts) if(i) freeArray(i);
+	for(auto i: tails) if(i) freeArray(i);
+	if(accumulator) freeArray(accumulator);
+	if(workspace) freeArray(workspace);
+	if(real_fft) delete real_fft;
+}
+
+void FftMatrixConvolver::setResponse(int input, int output, int length, float* response) {
+	int index = input*output_count+output;
+	responses[index].assign(response, response+length);
+	int maxLength = 1;
+	for(auto &i: responses) maxLength = std::max(maxLength, (int)i.size());
+	int neededLength = realFftNextFastSize(block_size+maxLength);
+	if(neededLength != workspace_size) {
+		workspace_size = neededLength;
+		fft_size = neededLength/2+1;
+		tail_size = neededLength-block_size;
+		if(workspace) freeArray(workspace);
+		workspace = allocArray<float>(workspace_size);
+		if(accumulator) freeArray(accumulator);
+		accumulator = allocArray<kiss_fft_cpx>(fft_size);
+		for(auto &i: input_ffts) {
+			if(i) freeArray(i);
+			i = allocArray<kiss_fft_cpx>(fft_size);
+		}
+		//allocArray zeroes, so this also clears the history.
+		for(auto &i: tails) {
+			if(i) freeArray(i);
+			i = allocArray<float>(tail_size);
+		}
+		if(real_fft) delete real_fft;
+		real_fft = new RealFft(workspace_size);
+		for(int i = 0; i < input_count*output_count; i++) computeResponseFft(i);
+	}
+	else computeResponseFft(index);
+}
+
+void FftMatrixConvolver::computeResponseFft(int index) {
+	auto &response = responses[index];
+	if(response_ffts[index]) freeArray(response_ffts[index]);
+	response_ffts[index] = nullptr;
+	if(response.size() == 0) return;
+	response_ffts[index] = allocArray<kiss_fft_cpx>(fft_size);
+	std::fill(workspace, workspace+workspace_size, 0.0f);
+	std::copy(response.begin(), response.end(), workspace);
+	real_fft->forward(workspace, response_ffts[index]);
+}
+
+void FftMatrixConvolver::convolve(float** inputs, float** outputs) {
+	//Transform every input which feeds at least one output.
+	for(int i = 0; i < input_count; i++) {
+		bool needed = false;
+		for(int o = 0; o < output_count; o++) needed = needed || response_ffts[i*output_count+o];
+		if(needed == false) continue;
+		std::copy(inputs[i], inputs[i]+block_size, workspace);
+		std::fill(workspace+block_size, workspace+workspace_size, 0.0f);
+		real_fft->forward(workspace, input_ffts[i]);
+	}
+	for(int o = 0; o < output_count; o++) {
+		bool hasInput = false;
+		std::fill(accumulator, accumulator+fft_size, kiss_fft_cpx{0.0f, 0.0f});
+		for(int i = 0; i < input_count; i++) {
+			kiss_fft_cpx* response = response_ffts[i*output_count+o];
+			if(response == nullptr) continue;
+			hasInput = true;
+			kiss_fft_cpx* in = input_ffts[i];
+			//Complex multiply and accumulate.
+			for(int j = 0; j < fft_size; j++) {
+				accumulator[j].r += in[j].r*response[j].r-in[j].i*response[j].i;
+				accumulator[j].i += in[j].r*response[j].i+in[j].i*response[j].r;
+			}
+		}
+		//Nothing feeds this output, but we still have to let the tail ring out.
+		if(hasInput) real_fft->inverse(accumulator, workspace);
+		else std::fill(workspace, workspace+workspace_size, 0.0f);
+		additionKernel(tail_size, tails[o], workspace, workspace);
+		scalarMultiplicationKernel(block_size, 1.0f/workspace_size, workspace, outputs[o]);
+		std::copy(workspace+block_size, workspace+workspace_size, tails[o]);
+	}
+}
+
+void FftMatrixConvolver::reset() {
+	for(auto i: tails) std::fill(i, i+tail_size, 0.0f);
+}
+
+int FftMatrixConvolver::getInputCount() {
+	return input_count;
+}
+
+int FftMatrixConvolver::getOutputCount() {
+	return output_count;
+}
+
+}
@@ -14,7 +14,10 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <math.h>
 #include <libaudioverse/private/constants.hpp>
 #include <stdio.h>
+#include <string.h>
 #include <libaudioverse/private/error.hpp>
+#include <complex>
+#include <vector>
 
 namespace libaudioverse_implementation {
 
@@ -22,6 +25,13 @@ IIRFilter::IIRFilter(double sr) {
 	this->sr = sr;
 }
 
+IIRFilter::~IIRFilter() {
+	if(history) delete[] history;
+	if(numerator) delete[] numerator;
+	if(denominator) delete[] denominator;
+	if(recursion_history) delete[] recursion_history;
+}
+
 void IIRFilter::configure(int newNumeratorLength, double* newNumerator, int newDenominatorLength, double* newDenominator) {
 	if(newNumeratorLength == 0 || newDenominatorLength == 0) ERROR(Lav_ERROR_RANGE, "Both numerator and denominator must have nonzero length.");
 	//we normalize by the first coefficient but throw it out; consequently, it must be nonzero.
@@ -31,8 +41,11 @@ void IIRFilter::configure(int newNumeratorLength, double* newNumerator, int newD
 		if(numerator) delete[] numerator;
 		if(denominator) delete[] denominator;
 		if(recursion_history) delete[] recursion_history;
-		history = new double[newNumeratorLength]();
-		recursion_history = new double[newDenominatorLength]();
+		history = new double[2*newNumeratorLength]();
+		//The recursion doesn't need the newest output, only the previous denominatorLength-1.
+		recursion_history = new double[2*newDenominatorLength]();
+		history_position = 0;
+		recursion_history_position = 0;
 		numerator = new double[newNumeratorLength]();
 		denominator = new double[newDenominatorLength]();
 	}
@@ -40,12 +53,15 @@ void IIRFilter::configure(int newNumeratorLength, double* newNumerator, int newD
 	std::copy(newDenominator, newDenominator+newDenominatorLength, denominator);
 	numerator_length= newNumeratorLength;
 	denominator_length = newDenominatorLength;
-	for(int i = 0; i <denominator_length; i++) denominator[i]/=denominator[0];
+	//Save the first coefficient, or it divides itself to 1 before the rest.
+	double a0 = denominator[0];
+	for(int i = 0; i < numerator_length; i++) numerator[i] /= a0;
+	for(int i = 0; i <denominator_length; i++) denominator[i]/=a0;
 }
 
 void IIRFilter::clearHistories() {
-	if(numerator_length) memset(history, 0, sizeof(double)*numerator_length);
-	if(denominator_length) memset(recursion_history, 0, sizeof(double)*denominator_length);
+	if(numerator_length) memset(history, 0, sizeof(double)*2*numerator_length);
+	if(denominator_length) memset(recursion_history, 0, sizeof(double)*2*denominator_length);
 }
 
 void IIRFilter::setGain(double gain) {
@@ -53,19 +69,19 @@ void IIRFilter::setGain(double gain) {
 }
 
 float IIRFilter::tick(float sample) {
-	int i;
-	history[0] = sample*gain;
-	recursion_history[0] = 0.0;
-	for(i= numerator_length-1; i > 0; i--) {
-		recursion_history[0]+=history[i]*numerator[i];
-		history[i]=history[i-1];
-	}
-	recursion_history[0]+=history[0]*numerator[0];
-	for(i = denominator_length-1 ; i >0; i--) {
-		recursion_history[0]+=-denominator[i]*recursion_history[i];
-		recursion_history[i]=recursion_history[i-1];
-	}
-	return (float)recursion_history[0];
+	//Both rings run backwards, so that the values from newest to oldest are contiguous starting at the position.
+	history_position = history_position == 0 ? numerator_length-1 : history_position-1;
+	history[history_position] = history[history_position+numerator_length] = sample*gain;
+	double* x = history+history_position;
+	double result = 0.0;
+	for(int i = 0; i < numerator_length; i++) result += numerator[i]*x[i];
+	int recursionLength = denominator_length-1;
+	if(recursionLength == 0) return (float)result;
+	double* y = recursion_history+recursion_history_position;
+	for(int i = 0; i < recursionLength; i++) result -= denominator[i+1]*y[i];
+	recursion_history_position = recursion_history_position == 0 ? recursionLength-1 : recursion_history_position-1;
+	recursion_history[recursion_history_position] = recursion_history[recursion_history_position+recursionLength] = result;
+	return (float)result;
 }
 
 void IIRFilter::configureBiquad(int type, double frequency, double dbGain, double q) {
@@ -77,6 +93,218 @@ void IIRFilter::configureBiquad(int type, double frequency, double dbGain, doubl
 	setGain(b0/a0);
 }
 
+typedef std::complex<double> IirComplex;
+
+//Evaluate a polynomial with the highest power first.
+IirComplex evaluatePolynomial(const std::vector<IirComplex> &coefficients, IirComplex z) {
+	IirComplex result = 0.0;
+	for(auto &c: coefficients) result = result*z+c;
+	return result;
+}
+
+std::vector<IirComplex> differentiatePolynomial(const std::vector<IirComplex> &coefficients) {
+	int degree = coefficients.size()-1;
+	std::vector<IirComplex> result;
+	for(int i = 0; i < degree; i++) result.push_back(coefficients[i]*(double)(degree-i));
+	if(result.empty()) result.push_back(0.0);
+	return result;
+}
+
+//Roots of a monic polynomial with the highest power first, by Durand-Kerner.
+//Repeated roots, which filters made by cascading identical sections have lots of, only converge to a ring around the true root.
+//The ring gets wider as the multiplicity goes up, so these are cleaned up afterwords by clusterRoots.
+bool findPolynomialRoots(const std::vector<IirComplex> &monic, std::vector<IirComplex> &roots) {
+	int degree = monic.size()-1;
+	roots.clear();
+	if(degree <= 0) return true;
+	roots.resize(degree);
+	IirComplex seed(0.4, 0.9);
+	roots[0] = 1.0;
+	for(int i = 1; i < degree; i++) roots[i] = roots[i-1]*seed;
+	//Whether or not this converges fully, the caller checks the result.
+	bool converged = false;
+	for(int iteration = 0; iteration < 1000 && converged == false; iteration++) {
+		converged = true;
+		for(int i = 0; i < degree; i++) {
+			IirComplex denominator = 1.0;
+			for(int j = 0; j < degree; j++) if(j != i) denominator *= roots[i]-roots[j];
+			if(std::abs(denominator) == 0.0) return false;
+			IirComplex delta = evaluatePolynomial(monic, roots[i])/denominator;
+			roots[i] -= delta;
+			if(std::abs(delta) > 1e-14*std::max(1.0, std::abs(roots[i]))) converged = false;
+		}
+	}
+	return true;
+}
+
+//Group roots closer than tolerance (relative to their size) into clusters, and replace each cluster of m roots with one root of multiplicity m.
+//An m-fold root of p is a simple root of the (m-1)th derivative of p, so the cluster's mean is polished with Newton's method on that.
+//If the cluster is wider than its mean is far from the real axis, it's a real repeated root split by rounding error, and is snapped to the axis.
+std::vector<IirComplex> clusterRoots(const std::vector<IirComplex> &monic, const std::vector<IirComplex> &roots, double tolerance) {
+	int degree = roots.size();
+	std::vector<int> cluster(degree, -1);
+	for(int i = 0; i < degree; i++) {
+		if(cluster[i] != -1) continue;
+		cluster[i] = i;
+		//Grow the cluster until nothing else is close to any member.
+		for(bool grew = true; grew;) {
+			grew = false;
+			for(int j = 0; j < degree; j++) {
+				if(cluster[j] != -1) continue;
+				for(int k = 0; k < degree; k++) {
+					if(cluster[k] == i && std::abs(roots[j]-roots[k]) < tolerance*std::max(1.0, std::abs(roots[k]))) {
+						cluster[j] = i;
+						grew = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+	std::vector<IirComplex> result(roots);
+	for(int i = 0; i < degree; i++) {
+		if(cluster[i] != i) continue;
+		IirComplex mean = 0.0;
+		int count = 0;
+		for(int j = 0; j < degree; j++) if(cluster[j] == i) {
+			mean += roots[j];
+			count++;
+		}
+		mean /= (double)count;
+		double spread = 0.0;
+		for(int j = 0; j < degree; j++) if(cluster[j] == i) spread = std::max(spread, std::abs(roots[j]-mean));
+		auto q = monic;
+		for(int k = 1; k < count; k++) q = differentiatePolynomial(q);
+		auto dq = differentiatePolynomial(q);
+		for(int k = 0; k < 5; k++) {
+			IirComplex d = evaluatePolynomial(dq, mean);
+			if(std::abs(d) == 0.0) break;
+			IirComplex next = mean-evaluatePolynomial(q, mean)/d;
+			//Newton can wander off if the cluster wasn't really one root; the caller catches that, but don't make it worse.
+			if(std::abs(evaluatePolynomial(q, next)) >= std::abs(evaluatePolynomial(q, mean))) break;
+			mean = next;
+		}
+		if(count > 1 && fabs(mean.imag()) <= spread) mean = mean.real();
+		for(int j = 0; j < degree; j++) if(cluster[j] == i) result[j] = mean;
+	}
+	return result;
+}
+
+//Turn roots into real quadratic factors (1, c1, c2), as coefficients of z^-1: conjugate pairs together, then the real roots in pairs.
+bool pairRoots(std::vector<IirComplex> roots, std::vector<IirComplex> &pairs, std::vector<IirSection> &factors) {
+	const double tolerance = 1e-7;
+	std::vector<double> reals;
+	std::vector<IirComplex> upper, lower;
+	for(auto &r: roots) {
+		if(fabs(r.imag()) <= tolerance*std::max(1.0, std::abs(r))) reals.push_back(r.real());
+		else if(r.imag() > 0) upper.push_back(r);
+		else lower.push_back(r);
+	}
+	if(upper.size() != lower.size()) return false;
+	factors.clear();
+	pairs.clear();
+	for(auto &r: upper) {
+		//Check that the conjugate is actually there.
+		auto best = std::min_element(lower.begin(), lower.end(), [&] (const IirComplex &a, const IirComplex &b) {
+			return std::abs(a-std::conj(r)) < std::abs(b-std::conj(r));
+		});
+		if(std::abs(*best-std::conj(r)) > 1e-6*std::max(1.0, std::abs(r))) return false;
+		lower.erase(best);
+		factors.push_back({1.0, -2.0*r.real(), std::norm(r), 0.0, 0.0});
+		pairs.push_back(r);
+	}
+	std::sort(reals.begin(), reals.end());
+	for(unsigned int i = 0; i < reals.size(); i += 2) {
+		if(i+1 < reals.size()) {
+			factors.push_back({1.0, -(reals[i]+reals[i+1]), reals[i]*reals[i+1], 0.0, 0.0});
+			pairs.push_back(fabs(reals[i]) > fabs(reals[i+1]) ? reals[i] : reals[i+1]);
+		}
+		else {
+			factors.push_back({1.0, -reals[i], 0.0, 0.0, 0.0});
+			pairs.push_back(reals[i]);
+		}
+	}
+	return true;
+}
+
+//Factor a polynomial in z^-1 into quadratic factors (1, c1, c2), stored in b0, b1, and b2, which multiply back out to polynomial/polynomial[0].
+//Pairs gets one root from each factor, for matching poles with zeros.
+bool factorPolynomial(const std::vector<double> &polynomial, std::vector<IirComplex> &pairs, std::vector<IirSection> &factors) {
+	//Multiplying through by the highest power of z turns this into an ordinary polynomial in z with the same coefficients.
+	std::vector<IirComplex> monic;
+	for(auto &c: polynomial) monic.push_back(c/polynomial[0]);
+	std::vector<IirComplex> raw;
+	if(findPolynomialRoots(monic, raw) == false) return false;
+	double largest = 0.0;
+	for(auto &c: monic) largest = std::max(largest, std::abs(c));
+	//Try looser and looser clusterings, until the factors give back the polynomial we started with.
+	//The first tolerance doesn't cluster anything, so filters without repeated roots are factored as is.
+	const double tolerances[] = {0.0, 1e-9, 1e-7, 1e-5, 1e-4, 1e-3, 3e-3, 1e-2, 3e-2, 0.1, 0.3, 1.0};
+	for(double tolerance: tolerances) {
+		if(pairRoots(clusterRoots(monic, raw, tolerance), pairs, factors) == false) continue;
+		std::vector<double> check(1, 1.0);
+		for(auto &f: factors) {
+			std::vector<double> product(check.size()+2, 0.0);
+			for(unsigned int i = 0; i < check.size(); i++) {
+				product[i] += check[i];
+				product[i+1] += check[i]*f.b1;
+				product[i+2] += check[i]*f.b2;
+			}
+			check = product;
+		}
+		double error = 0.0;
+		for(unsigned int i = 0; i < check.size(); i++) error = std::max(error, fabs(check[i]-(i < monic.size() ? monic[i].real() : 0.0)));
+		if(error <= 1e-6*largest) return true;
+	}
+	return false;
+}
+
+//Coefficients of a polynomial in z^-1, lowest power first, with trailing zeros removed.
+std::vector<double> trimmedPolynomial(int length, double* coefficients) {
+	std::vector<double> result;
+	if(length > 0) result.assign(coefficients, coefficients+length);
+	while(result.size() > 1 && result.back() == 0.0) result.pop_back();
+	return result;
+}
+
+bool factorIirFilter(int numeratorLength, double* numerator, int denominatorLength, double* denominator, double &gain, std::vector<IirSection> &sections) {
+	auto num = trimmedPolynomial(numeratorLength, numerator);
+	auto den = trimmedPolynomial(denominatorLength, denominator);
+	if(num.empty() || den.empty()) return false;
+	//A leading zero is a delay, which sections can't represent.
+	if(num[0] == 0.0 || den[0] == 0.0) return false;
+	gain = num[0]/den[0];
+	std::vector<IirComplex> zeroPairs, polePairs;
+	std::vector<IirSection> zeroFactors, poleFactors;
+	if(factorPolynomial(num, zeroPairs, zeroFactors) == false || factorPolynomial(den, polePairs, poleFactors) == false) return false;
+	//Give each pole pair its nearest zero pair, starting with the poles nearest the unit circle.
+	std::vector<int> order(poleFactors.size());
+	for(unsigned int i = 0; i < order.size(); i++) order[i] = i;
+	std::sort(order.begin(), order.end(), [&] (int a, int b) {return std::abs(polePairs[a]) > std::abs(polePairs[b]);});
+	sections.clear();
+	std::vector<bool> used(zeroFactors.size(), false);
+	for(int p: order) {
+		int best = -1;
+		for(unsigned int z = 0; z < zeroFactors.size(); z++) {
+			if(used[z]) continue;
+			if(best == -1 || std::abs(zeroPairs[z]-polePairs[p]) < std::abs(zeroPairs[best]-polePairs[p])) best = z;
+		}
+		IirSection s = {1.0, 0.0, 0.0, poleFactors[p].b1, poleFactors[p].b2};
+		if(best != -1) {
+			used[best] = true;
+			s.b1 = zeroFactors[best].b1;
+			s.b2 = zeroFactors[best].b2;
+		}
+		sections.push_back(s);
+	}
+	for(unsigned int z = 0; z < zeroFactors.size(); z++) {
+		if(used[z] == false) sections.push_back({1.0, zeroFactors[z].b1, zeroFactors[z].b2, 0.0, 0.0});
+	}
+	//Run the least resonant sections first.
+	std::reverse(sections.begin(), sections.end());
+	return true;
+}
+
 double IIRFilter::qFromBw(double frequency, double bw) {
 	return frequency/bw;
 }
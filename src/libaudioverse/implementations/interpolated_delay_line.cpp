@@ -3,6 +3,7 @@ This file is part of Libaudioverse, a library for 3D and environmental audio sim
 A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
 #include <libaudioverse/private/dspmath.hpp>
 #include <libaudioverse/implementations/delayline.hpp>
+#include <libaudioverse/private/kernels.hpp>
 #include <algorithm>
 #include <functional>
 #include <math.h>
@@ -45,6 +46,36 @@ void InterpolatedDelayLine::advance(float sample) {
 	line.advance(sample);
 }
 
+int InterpolatedDelayLine::getBlockLimit() {
+	return std::min((int)delay, max_delay)+1;
+}
+
+float InterpolatedDelayLine::computeSampleAhead(int ahead) {
+	//The same arithmetic as computeSample, so that block processing gives identical output.
+	float w1 = delay-floorf(delay);
+	float w2 = 1-w1;
+	int i1 = (int)(delay);
+	int i2=i1+1;
+	i1 =std::min(i1, max_delay);
+	i2=std::min(i2, max_delay);
+	return line.read(i1-ahead)*w1+line.read(i2-ahead)*w2;
+}
+
+void InterpolatedDelayLine::computeBlock(int length, float* output) {
+	//As computeSampleAhead, but a block at a time.
+	float w1 = delay-floorf(delay);
+	float w2 = 1-w1;
+	int i1 = std::min((int)delay, max_delay);
+	int i2 = std::min((int)delay+1, max_delay);
+	line.readBlock(i2, length, output);
+	scalarMultiplicationKernel(length, w2, output, output);
+	line.mixBlock(i1, length, w1, output);
+}
+
+void InterpolatedDelayLine::advanceBlock(int length, const float* input) {
+	line.writeBlock(length, input);
+}
+
 void InterpolatedDelayLine::reset() {
 	line.reset();
 }
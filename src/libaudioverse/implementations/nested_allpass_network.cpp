@@ -8,8 +8,6 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/implementations/nested_allpass_network.hpp>
 #include <libaudioverse/implementations/biquad.hpp>
 #include <libaudioverse/implementations/one_pole_filter.hpp>
-#include <libaudioverse/implementations/allpass.hpp>
-#include <libaudioverse/implementations/delayline.hpp>
 //Get the biquad types:
 #include <libaudioverse/libaudioverse_properties.h>
 #include <algorithm>
@@ -19,54 +17,8 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 
 namespace libaudioverse_implementation {
 
-NestedAllpassNetworkASTNode::NestedAllpassNetworkASTNode(NestedAllpassNetwork* source, NestedAllpassNetworkASTTypes type, void* filter) {
-	this->source = source;
+NestedAllpassNetworkASTNode::NestedAllpassNetworkASTNode(NestedAllpassNetworkASTTypes type) {
 	this->type = type;
-	this->filter = filter;
-}
-
-NestedAllpassNetworkASTNode::~NestedAllpassNetworkASTNode() {
-	if(type == NestedAllpassNetworkASTTypes::ALLPASS || type == NestedAllpassNetworkASTTypes::NESTED_ALLPASS) delete (AllpassFilter<InterpolatedDelayLine>*)filter;
-	else if(type == NestedAllpassNetworkASTTypes::ONE_POLE) delete (OnePoleFilter*)filter;
-	else if(type == NestedAllpassNetworkASTTypes::BIQUAD) delete (BiquadFilter*)filter;
-	else if(type == NestedAllpassNetworkASTTypes::BIQUAD) delete (BiquadFilter*)filter;
-}
-
-//Tick and reset follow a similar pattern.
-float NestedAllpassNetworkASTNode::tick(float input) {
-	if(type == NestedAllpassNetworkASTTypes::IDENTITY) return input;
-	else if(type == NestedAllpassNetworkASTTypes::ALLPASS) return static_cast<AllpassFilter<InterpolatedDelayLine>*>(filter)->tick(input);
-	else if(type == NestedAllpassNetworkASTTypes::ONE_POLE) return static_cast<OnePoleFilter*>(filter)->tick(input);
-	else if(type == NestedAllpassNetworkASTTypes::BIQUAD) return static_cast<BiquadFilter*>(filter)->tick(input);
-	else if(type == NestedAllpassNetworkASTTypes::NESTED_ALLPASS) {
-		float tmp = static_cast<AllpassFilter<InterpolatedDelayLine>*>(filter)->beginNestedTick();
-		tmp = nested->tickRow(tmp);
-		return static_cast<AllpassFilter<InterpolatedDelayLine>*>(filter)->endNestedTick(input, tmp);
-	} 
-	//Read the output and add it.
-	else if(type == NestedAllpassNetworkASTTypes::READER) {
-		source->contribute(input*reader_mul);
-		return input;
-	}
-	return 0.0f;
-}
-
-float NestedAllpassNetworkASTNode::tickRow(float input) {
-	auto current = this;
-	while(current) {
-		input = current->tick(input);
-		current = current->next;
-	}
-	return input;
-}
-
-void NestedAllpassNetworkASTNode::reset() {
-	if(type == NestedAllpassNetworkASTTypes::ALLPASS
-	|| type == NestedAllpassNetworkASTTypes::NESTED_ALLPASS) static_cast<AllpassFilter<InterpolatedDelayLine>*>(filter)->reset();
-	else if(type == NestedAllpassNetworkASTTypes::BIQUAD) static_cast<BiquadFilter*>(filter)->reset();
-	else if(type == NestedAllpassNetworkASTTypes::ONE_POLE) static_cast<OnePoleFilter*>(filter)->reset();
-	if(nested) nested->reset();
-	if(next) next->reset();
 }
 
 //Okay, implement the network itself.
@@ -78,20 +30,31 @@ NestedAllpassNetwork::NestedAllpassNetwork(float sr) {
 static void freeAST(NestedAllpassNetworkASTNode* start) {
 	if(start == nullptr) return;
 	NestedAllpassNetworkASTNode *next = start->next, *nested = start->nested;
+	delete start;
 	freeAST(next);
 	freeAST(nested);
 }
 
 NestedAllpassNetwork::~NestedAllpassNetwork() {
-	freeAST(start);
 	freeAST(next_start);
 }
 
+NestedAllpassNetworkASTNode* NestedAllpassNetwork::makeAllpass(NestedAllpassNetworkASTTypes type, int delay, float coefficient) {
+	auto n = new NestedAllpassNetworkASTNode(type);
+	n->stage.coefficient = coefficient;
+	//Size and read the line exactly as an InterpolatedDelayLine with this delay would, so that networks sound the same as they always have.
+	float maxDelay = (float)((delay+1)/(double)sr);
+	int maxDelaySamples = (int)(sr*maxDelay)+1;
+	delay = std::min(delay, maxDelaySamples);
+	n->stage.line_read = std::min(delay+1, maxDelaySamples);
+	unsigned int length = 1;
+	while(length <= (unsigned int)maxDelaySamples) length <<= 1;
+	n->stage.line_length = length;
+	return n;
+}
+
 void NestedAllpassNetwork::beginNesting(int delay, float coefficient) {
-	auto filter = new AllpassFilter<InterpolatedDelayLine>((delay+1)/(double)sr, sr);
-	filter->line.setDelayInSamples(delay);
-	filter->setCoefficient(coefficient);
-	auto node = new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::NESTED_ALLPASS, filter);
+	auto node = makeAllpass(NestedAllpassNetworkASTTypes::NESTED_ALLPASS, delay, coefficient);
 	hookupAST(node);
 	//Now move current to the stack and kill it.
 	stack.push_back(current);
@@ -106,48 +69,84 @@ void NestedAllpassNetwork::endNesting() {
 	if(slave) slave->endNesting();
 }
 
-//The rest of these follow a very simple pattern: create and configure filter, make node, put node in.
+//The rest of these follow a very simple pattern: work out the coefficients, make node, put node in.
 void NestedAllpassNetwork::appendAllpass(int delay, float coefficient) {
-	auto f = new AllpassFilter<InterpolatedDelayLine>((delay+1)/(double)sr, sr);
-	f->setCoefficient(coefficient);
-	f->line.setDelayInSamples(delay);
-	auto n = new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::ALLPASS, f);
+	auto n = makeAllpass(NestedAllpassNetworkASTTypes::ALLPASS, delay, coefficient);
 	hookupAST(n);
 	if(slave) slave->appendAllpass(delay, coefficient);
 }
 
 void NestedAllpassNetwork::appendOnePole(float frequency, bool isHighpass) {
-	auto f = new OnePoleFilter(sr);
-	f->setPoleFromFrequency(frequency, isHighpass);
-	auto n = new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::ONE_POLE, f);
+	OnePoleFilter f(sr);
+	f.setPoleFromFrequency(frequency, isHighpass);
+	auto n = new NestedAllpassNetworkASTNode(NestedAllpassNetworkASTTypes::ONE_POLE);
+	n->stage.pole_b0 = f.b0;
+	n->stage.pole_a1 = f.a1;
 	hookupAST(n);
 	if(slave) slave->appendOnePole(frequency, isHighpass);
 }
 
 void NestedAllpassNetwork::appendBiquad(int type, double frequency, double dbGain, double q) {
-	auto f = new BiquadFilter(sr);
-	f->configure(type, frequency, dbGain, q);
-	auto n =  new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::BIQUAD, f);
+	BiquadFilter f(sr);
+	f.configure(type, frequency, dbGain, q);
+	auto n =  new NestedAllpassNetworkASTNode(NestedAllpassNetworkASTTypes::BIQUAD);
+	n->stage.b0 = f.b0;
+	n->stage.b1 = f.b1;
+	n->stage.b2 = f.b2;
+	n->stage.a1 = f.a1;
+	n->stage.a2 = f.a2;
 	hookupAST(n);
 	if(slave) slave->appendBiquad(type, frequency, dbGain, q);
 }	
 
 void NestedAllpassNetwork::appendReader(float mul) {
-	auto n = new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::READER, nullptr);
-	n->reader_mul = mul;
+	auto n = new NestedAllpassNetworkASTNode(NestedAllpassNetworkASTTypes::READER);
+	n->stage.coefficient = mul;
 	hookupAST(n);
 	if(slave) slave->appendReader(mul);
 }
 
+void NestedAllpassNetwork::flatten(NestedAllpassNetworkASTNode* node, std::vector<NestedAllpassNetworkStage> &into, int depth) {
+	max_depth = std::max(max_depth, depth);
+	for(; node; node = node->next) {
+		NestedAllpassNetworkStage stage = node->stage;
+		switch(node->type) {
+			case NestedAllpassNetworkASTTypes::READER: stage.type = NestedAllpassNetworkStageTypes::READER; break;
+			case NestedAllpassNetworkASTTypes::ALLPASS: stage.type = NestedAllpassNetworkStageTypes::ALLPASS; break;
+			case NestedAllpassNetworkASTTypes::ONE_POLE: stage.type = NestedAllpassNetworkStageTypes::ONE_POLE; break;
+			case NestedAllpassNetworkASTTypes::BIQUAD: stage.type = NestedAllpassNetworkStageTypes::BIQUAD; break;
+			case NestedAllpassNetworkASTTypes::NESTED_ALLPASS:
+			stage.type = NestedAllpassNetworkStageTypes::BEGIN_NESTED_ALLPASS;
+			break;
+		}
+		into.push_back(stage);
+		if(node->type == NestedAllpassNetworkASTTypes::NESTED_ALLPASS) {
+			int begin = into.size()-1;
+			flatten(node->nested, into, depth+1);
+			NestedAllpassNetworkStage end;
+			end.type = NestedAllpassNetworkStageTypes::END_NESTED_ALLPASS;
+			end.partner = begin;
+			into.push_back(end);
+		}
+	}
+}
+
 void NestedAllpassNetwork::compile() {
-	//If the stack has things on it and the current node is nullptr, we just began nesting.
-	//In this case,we apend an identity node to the node at the back of the stack.
-	if(current == nullptr && stack.size()) {
-		auto n = new NestedAllpassNetworkASTNode(this, NestedAllpassNetworkASTTypes::IDENTITY, nullptr);
-		stack.back()->nested = n;
+	std::vector<NestedAllpassNetworkStage> compiled;
+	max_depth = 0;
+	flatten(next_start, compiled, 0);
+	//Lay the lines out one after another in the order they're used.
+	unsigned int memory = 0;
+	for(auto &s: compiled) {
+		if(s.type != NestedAllpassNetworkStageTypes::ALLPASS && s.type != NestedAllpassNetworkStageTypes::BEGIN_NESTED_ALLPASS) continue;
+		s.line_start = memory;
+		memory += s.line_length;
 	}
-	//start becomes next_start, clear everything else.
-	start = next_start;
+	stages = compiled;
+	delay_memory.assign(memory, 0.0f);
+	nesting_inputs.assign(max_depth, 0.0f);
+	//The tree isn't needed anymore; start a new one.
+	freeAST(next_start);
 	current = nullptr;
 	next_start = nullptr;
 	stack.clear();
@@ -173,18 +172,65 @@ void NestedAllpassNetwork::hookupAST(NestedAllpassNetworkASTNode *node) {
 	}
 }
 
-void NestedAllpassNetwork::contribute(float amount) {
-	next_output += amount;
+static inline float readLine(NestedAllpassNetworkStage &s, float* memory) {
+	return memory[s.line_start+((s.line_head-s.line_read)&(s.line_length-1))];
+}
+
+//The end of AllpassFilter::endNestedTick.
+static inline float finishAllpass(NestedAllpassNetworkStage &s, float* memory, float input, float lineValue) {
+	float rec = input-s.coefficient*lineValue;
+	float out = s.coefficient*rec+lineValue;
+	s.line_head++;
+	memory[s.line_start+(s.line_head&(s.line_length-1))] = rec;
+	return out;
 }
 
 float NestedAllpassNetwork::tick(float input) {
-	next_output = 0.0f;
-	if(start) start->tickRow(input);
-	return next_output;
+	float output = 0.0f, value = input;
+	NestedAllpassNetworkStage* program = stages.data();
+	float* memory = delay_memory.data();
+	float* inputs = nesting_inputs.data();
+	int depth = 0;
+	for(int i = 0, count = stages.size(); i < count; i++) {
+		auto &s = program[i];
+		switch(s.type) {
+			case NestedAllpassNetworkStageTypes::READER:
+			output += value*s.coefficient;
+			break;
+			case NestedAllpassNetworkStageTypes::ALLPASS:
+			value = finishAllpass(s, memory, value, readLine(s, memory));
+			break;
+			case NestedAllpassNetworkStageTypes::ONE_POLE:
+			value = s.pole_b0*value-s.pole_a1*s.pole_last;
+			s.pole_last = value;
+			break;
+			case NestedAllpassNetworkStageTypes::BIQUAD: {
+				double recursive = value-s.a1*s.h1-s.a2*s.h2;
+				value = (float)(s.b0*recursive+s.b1*s.h1+s.b2*s.h2);
+				s.h2 = s.h1;
+				s.h1 = recursive;
+				break;
+			}
+			//The nested stages filter the line's output before the allpass finishes.
+			case NestedAllpassNetworkStageTypes::BEGIN_NESTED_ALLPASS:
+			inputs[depth++] = value;
+			value = readLine(s, memory);
+			break;
+			case NestedAllpassNetworkStageTypes::END_NESTED_ALLPASS:
+			value = finishAllpass(program[s.partner], memory, inputs[--depth], value);
+			break;
+		}
+	}
+	return output;
 }
 
 void NestedAllpassNetwork::reset() {
-	if(start) start->reset();
+	std::fill(delay_memory.begin(), delay_memory.end(), 0.0f);
+	for(auto &s: stages) {
+		s.pole_last = 0.0f;
+		s.h1 = 0.0;
+		s.h2 = 0.0;
+	}
 }
 
 NestedAllpassNetwork* NestedAllpassNetwork::getSlave() {
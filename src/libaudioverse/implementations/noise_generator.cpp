@@ -0,0 +1,179 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/implementations/noise_generator.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <math.h>
+#include <stdint.h>
+#include <mmintrin.h>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace libaudioverse_implementation {
+
+NoiseGenerator::NoiseGenerator(uint32_t seed) {
+	this->seed(seed);
+}
+
+void NoiseGenerator::seed(uint32_t seed) {
+	//Splitmix64, the recommended way to fill xoshiro state from a small seed.
+	uint64_t x = seed;
+	for(int lane = 0; lane < 4; lane++) {
+		for(int word = 0; word < 4; word += 2) {
+			uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+			z = (z^(z >> 30))*0xbf58476d1ce4e5b9ULL;
+			z = (z^(z >> 27))*0x94d049bb133111ebULL;
+			z ^= z >> 31;
+			state[word][lane] = (uint32_t)z;
+			state[word+1][lane] = (uint32_t)(z >> 32);
+		}
+	}
+}
+
+//Xoshiro128+ on one lane.
+//Only the top 24 bits are used, which avoids the weak low bits.
+inline uint32_t noiseGeneratorNext(uint32_t state[4][4], int lane) {
+	uint32_t s0 = state[0][lane], s1 = state[1][lane], s2 = state[2][lane], s3 = state[3][lane];
+	uint32_t result = s0+s3;
+	uint32_t t = s1 << 9;
+	s2 ^= s0;
+	s3 ^= s1;
+	s1 ^= s2;
+	s0 ^= s3;
+	s2 ^= t;
+	s3 = (s3 << 11) | (s3 >> 21);
+	state[0][lane] = s0;
+	state[1][lane] = s1;
+	state[2][lane] = s2;
+	state[3][lane] = s3;
+	return result;
+}
+
+//In (0, 1], so that the logarithm is always finite.
+inline float noiseGeneratorUniform(uint32_t x) {
+	return ((x >> 8)+1)*(1.0f/16777216.0f);
+}
+
+float NoiseGenerator::normalSimple(float standardDeviation) {
+	float r = standardDeviation*sqrtf(-2.0f*logf(noiseGeneratorUniform(noiseGeneratorNext(state, 0))));
+	return r*cosf((float)(2*PI)*noiseGeneratorUniform(noiseGeneratorNext(state, 0)));
+}
+
+void NoiseGenerator::normal(int length, float* output, float standardDeviation, float limit) {
+	int groups = length/8*8;
+	for(int i = 0; i < groups; i += 8) normalGroup(output+i, standardDeviation);
+	if(groups < length) {
+		float last[8];
+		normalGroup(last, standardDeviation);
+		for(int i = groups; i < length; i++) output[i] = last[i-groups];
+	}
+	//Redraws are rare enough that there's no point in vectorizing them.
+	for(int i = 0; i < length; i++) {
+		while(output[i] < -limit || output[i] > limit) output[i] = normalSimple(standardDeviation);
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+
+//Natural logarithm of positive normal floats, from Cephes.
+inline __m128 noiseGeneratorLog(__m128 x) {
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128i bits = _mm_castps_si128(x);
+	__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+	//Mantissa in [0.5, 1).
+	x = _mm_or_ps(_mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff))), _mm_set1_ps(0.5f));
+	//Shift the mantissa to [sqrt(0.5), sqrt(2)) and subtract 1.
+	__m128 small = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+	e = _mm_sub_ps(e, _mm_and_ps(one, small));
+	x = _mm_add_ps(_mm_sub_ps(x, one), _mm_and_ps(x, small));
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(7.0376836292e-2f);
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+	y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+	y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	return _mm_add_ps(_mm_add_ps(x, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+//Sine and cosine of 2*pi*v for v in [0, 1], from Cephes.
+//V is split into a quarter turn and a remainder within an eighth of a turn, and the quarter turn swaps and negates the results.
+inline void noiseGeneratorSinCos(__m128 v, __m128 &sine, __m128 &cosine) {
+	__m128i quarter = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(4.0f)), _mm_set1_ps(0.5f)));
+	__m128 y = _mm_mul_ps(_mm_sub_ps(v, _mm_mul_ps(_mm_cvtepi32_ps(quarter), _mm_set1_ps(0.25f))), _mm_set1_ps((float)(2*PI)));
+	__m128 z = _mm_mul_ps(y, y);
+	__m128 s = _mm_set1_ps(-1.9515295891e-4f);
+	s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(8.3321608736e-3f));
+	s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(-1.6666654611e-1f));
+	s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), y), y);
+	__m128 c = _mm_set1_ps(2.443315711809948e-5f);
+	c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(-1.388731625493765e-3f));
+	c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+	c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+	//Odd quarters swap sine and cosine.
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quarter, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	sine = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+	cosine = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+	//Sine is negative in quarters 2 and 3, cosine in quarters 1 and 2.
+	__m128i sineSign = _mm_slli_epi32(_mm_and_si128(quarter, _mm_set1_epi32(2)), 30);
+	__m128i cosineSign = _mm_slli_epi32(_mm_xor_si128(quarter, _mm_srli_epi32(quarter, 1)), 31);
+	sine = _mm_xor_ps(sine, _mm_castsi128_ps(sineSign));
+	cosine = _mm_xor_ps(cosine, _mm_castsi128_ps(cosineSign));
+}
+
+inline __m128i noiseGeneratorStep(__m128i &s0, __m128i &s1, __m128i &s2, __m128i &s3) {
+	__m128i result = _mm_add_epi32(s0, s3);
+	__m128i t = _mm_slli_epi32(s1, 9);
+	s2 = _mm_xor_si128(s2, s0);
+	s3 = _mm_xor_si128(s3, s1);
+	s1 = _mm_xor_si128(s1, s2);
+	s0 = _mm_xor_si128(s0, s3);
+	s2 = _mm_xor_si128(s2, t);
+	s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+	return result;
+}
+
+inline __m128 noiseGeneratorUniform(__m128i x) {
+	return _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_srli_epi32(x, 8), _mm_set1_epi32(1))), _mm_set1_ps(1.0f/16777216.0f));
+}
+
+void NoiseGenerator::normalGroup(float* output, float standardDeviation) {
+	__m128i s0 = _mm_loadu_si128((__m128i*)state[0]), s1 = _mm_loadu_si128((__m128i*)state[1]);
+	__m128i s2 = _mm_loadu_si128((__m128i*)state[2]), s3 = _mm_loadu_si128((__m128i*)state[3]);
+	__m128 u1 = noiseGeneratorUniform(noiseGeneratorStep(s0, s1, s2, s3));
+	__m128 u2 = noiseGeneratorUniform(noiseGeneratorStep(s0, s1, s2, s3));
+	_mm_storeu_si128((__m128i*)state[0], s0);
+	_mm_storeu_si128((__m128i*)state[1], s1);
+	_mm_storeu_si128((__m128i*)state[2], s2);
+	_mm_storeu_si128((__m128i*)state[3], s3);
+	//-2 log(u1) can be slightly negative when u1 is 1, because the logarithm is approximate.
+	__m128 r = _mm_sqrt_ps(_mm_max_ps(_mm_mul_ps(noiseGeneratorLog(u1), _mm_set1_ps(-2.0f)), _mm_setzero_ps()));
+	r = _mm_mul_ps(r, _mm_set1_ps(standardDeviation));
+	__m128 sine, cosine;
+	noiseGeneratorSinCos(u2, sine, cosine);
+	_mm_storeu_ps(output, _mm_mul_ps(r, cosine));
+	_mm_storeu_ps(output+4, _mm_mul_ps(r, sine));
+}
+
+#else
+
+void NoiseGenerator::normalGroup(float* output, float standardDeviation) {
+	float u1[4], u2[4];
+	for(int lane = 0; lane < 4; lane++) u1[lane] = noiseGeneratorUniform(noiseGeneratorNext(state, lane));
+	for(int lane = 0; lane < 4; lane++) u2[lane] = noiseGeneratorUniform(noiseGeneratorNext(state, lane));
+	for(int lane = 0; lane < 4; lane++) {
+		float r = standardDeviation*sqrtf(-2.0f*logf(u1[lane]));
+		output[lane] = r*cosf((float)(2*PI)*u2[lane]);
+		output[lane+4] = r*sinf((float)(2*PI)*u2[lane]);
+	}
+}
+
+#endif
+
+}
@@ -0,0 +1,136 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/implementations/sin_osc_bank.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <math.h>
+#include <algorithm>
+#include <mmintrin.h>
+#include <emmintrin.h>
+
+namespace libaudioverse_implementation {
+
+SinOscBank::SinOscBank(float sr, int oscillators, int resync): sr(sr), oscillators(oscillators), resync(resync), resync_counter(resync),
+sx(oscillators, 0.0), cx(oscillators, 1.0), sd(oscillators, 0.0), cd(oscillators, 1.0),
+amplitudes(oscillators, 1.0), phases(oscillators, 0.0), phase_increments(oscillators, 0.0) {
+}
+
+int SinOscBank::getOscillatorCount() {
+	return oscillators;
+}
+
+void SinOscBank::setFrequency(int which, double frequency) {
+	phase_increments[which] = frequency/sr;
+	cd[which] = cos(phase_increments[which]*2*PI);
+	sd[which] = sin(phase_increments[which]*2*PI);
+}
+
+void SinOscBank::setAmplitude(int which, double amplitude) {
+	amplitudes[which] = amplitude;
+}
+
+void SinOscBank::setPhase(int which, double phase) {
+	phase -= floor(phase);
+	phases[which] = phase;
+	sx[which] = sin(2*PI*phase);
+	cx[which] = cos(2*PI*phase);
+}
+
+double SinOscBank::getPhase(int which) {
+	return phases[which];
+}
+
+void SinOscBank::reset() {
+	for(int i = 0; i < oscillators; i++) setPhase(i, 0.0);
+	resync_counter = resync;
+}
+
+void SinOscBank::doResync() {
+	for(int i = 0; i < oscillators; i++) {
+		sx[i] = sin(2*PI*phases[i]);
+		cx[i] = cos(2*PI*phases[i]);
+	}
+	resync_counter = resync;
+}
+
+void SinOscBank::process(int blockSize, float* output) {
+	if((int)sums.size() < 2*blockSize) sums.resize(2*blockSize);
+	std::fill(sums.begin(), sums.begin()+2*blockSize, 0.0);
+	int done = 0;
+	while(done < blockSize) {
+		int count = std::min(blockSize-done, resync_counter);
+		rotate(count, &sums[2*done]);
+		for(int i = 0; i < oscillators; i++) {
+			phases[i] += phase_increments[i]*count;
+			phases[i] -= floor(phases[i]);
+		}
+		done += count;
+		resync_counter -= count;
+		if(resync_counter == 0) doResync();
+	}
+	for(int i = 0; i < blockSize; i++) output[i] = (float)(sums[2*i]+sums[2*i+1]);
+}
+
+//One oscillator, for builds without SSE2 and for whatever doesn't fill a pair.
+void sinOscBankRotateSimple(int count, double amplitude, double sd, double cd, double &sx, double &cx, double* sums) {
+	for(int i = 0; i < count; i++) {
+		double osx = sx, ocx = cx;
+		//Output the old one, so that we start at phase zero properly.
+		sums[2*i] += amplitude*osx;
+		sx = osx*cd+ocx*sd;
+		cx = ocx*cd-osx*sd;
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+
+//Rotate 2 oscillators once, returning their outputs from before the rotation.
+inline __m128d sinOscBankStep(__m128d amplitude, __m128d sd, __m128d cd, __m128d &sx, __m128d &cx) {
+	__m128d out = _mm_mul_pd(amplitude, sx);
+	__m128d nsx = _mm_add_pd(_mm_mul_pd(sx, cd), _mm_mul_pd(cx, sd));
+	cx = _mm_sub_pd(_mm_mul_pd(cx, cd), _mm_mul_pd(sx, sd));
+	sx = nsx;
+	return out;
+}
+
+void SinOscBank::rotate(int count, double* sums) {
+	//Two pairs at once, so that one pair's rotation can overlap the other's.
+	int quads = oscillators/4*4;
+	int pairs = oscillators/2*2;
+	for(int o = 0; o < quads; o += 4) {
+		__m128d a1 = _mm_loadu_pd(&amplitudes[o]), sd1 = _mm_loadu_pd(&sd[o]), cd1 = _mm_loadu_pd(&cd[o]);
+		__m128d sx1 = _mm_loadu_pd(&sx[o]), cx1 = _mm_loadu_pd(&cx[o]);
+		__m128d a2 = _mm_loadu_pd(&amplitudes[o+2]), sd2 = _mm_loadu_pd(&sd[o+2]), cd2 = _mm_loadu_pd(&cd[o+2]);
+		__m128d sx2 = _mm_loadu_pd(&sx[o+2]), cx2 = _mm_loadu_pd(&cx[o+2]);
+		for(int i = 0; i < count; i++) {
+			__m128d out = _mm_add_pd(sinOscBankStep(a1, sd1, cd1, sx1, cx1), sinOscBankStep(a2, sd2, cd2, sx2, cx2));
+			_mm_storeu_pd(sums+2*i, _mm_add_pd(_mm_loadu_pd(sums+2*i), out));
+		}
+		_mm_storeu_pd(&sx[o], sx1);
+		_mm_storeu_pd(&cx[o], cx1);
+		_mm_storeu_pd(&sx[o+2], sx2);
+		_mm_storeu_pd(&cx[o+2], cx2);
+	}
+	if(quads < pairs) {
+		int o = quads;
+		__m128d a = _mm_loadu_pd(&amplitudes[o]), vsd = _mm_loadu_pd(&sd[o]), vcd = _mm_loadu_pd(&cd[o]);
+		__m128d vsx = _mm_loadu_pd(&sx[o]), vcx = _mm_loadu_pd(&cx[o]);
+		for(int i = 0; i < count; i++) {
+			__m128d out = sinOscBankStep(a, vsd, vcd, vsx, vcx);
+			_mm_storeu_pd(sums+2*i, _mm_add_pd(_mm_loadu_pd(sums+2*i), out));
+		}
+		_mm_storeu_pd(&sx[o], vsx);
+		_mm_storeu_pd(&cx[o], vcx);
+	}
+	for(int o = pairs; o < oscillators; o++) sinOscBankRotateSimple(count, amplitudes[o], sd[o], cd[o], sx[o], cx[o], sums);
+}
+
+#else
+
+void SinOscBank::rotate(int count, double* sums) {
+	for(int o = 0; o < oscillators; o++) sinOscBankRotateSimple(count, amplitudes[o], sd[o], cd[o], sx[o], cx[o], sums);
+}
+
+#endif
+
+}
@@ -0,0 +1,139 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/implementations/wavetable.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <math.h>
+#include <vector>
+#include <memory>
+#include <mmintrin.h>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace libaudioverse_implementation {
+
+//The amplitude of harmonic n, or 0 if the waveform doesn't have it.
+//All but the blit are sums of sines, scaled to swing between -1 and 1; the blit is a sum of cosines.
+double bandlimitedWaveformHarmonic(BandlimitedWaveforms waveform, int n) {
+	switch(waveform) {
+		case BandlimitedWaveforms::SQUARE: return n%2 ? 4.0/(PI*n) : 0.0;
+		case BandlimitedWaveforms::TRIANGLE: return n%2 ? ((n/2)%2 ? -1.0 : 1.0)*8.0/(PI*PI*n*n) : 0.0;
+		case BandlimitedWaveforms::SAW: return (n%2 ? 1.0 : -1.0)*2.0/(PI*n);
+		case BandlimitedWaveforms::BLIT: return 1.0;
+	}
+	return 0.0;
+}
+
+BandlimitedWavetable::BandlimitedWavetable(BandlimitedWaveforms waveform, int sr): sr(sr) {
+	const int length = bandlimited_wavetable_length;
+	//sin(2*pi*n*i/length) is always one of these, so building a table needs no trig.
+	std::vector<double> sines(length);
+	for(int i = 0; i < length; i++) sines[i] = sin(2*PI*i/length);
+	bool cosines = waveform == BandlimitedWaveforms::BLIT;
+	for(int harmonics = length/2; harmonics >= 1; harmonics /= 2) {
+		std::vector<double> sum(length, 0.0);
+		for(int n = 1; n <= harmonics; n++) {
+			double amplitude = bandlimitedWaveformHarmonic(waveform, n);
+			if(amplitude == 0.0) continue;
+			//cos(x) = sin(x+pi/2), a quarter of the table later.
+			int offset = cosines ? length/4 : 0;
+			for(int i = 0; i < length; i++) sum[i] += amplitude*sines[(n*i+offset)%length];
+		}
+		//The blit's peak is the number of harmonics, so it's normalized to peak at 1.
+		if(cosines) for(auto &s: sum) s /= harmonics;
+		std::vector<float> table(length+1);
+		for(int i = 0; i < length; i++) table[i] = (float)sum[i];
+		table[length] = table[0];
+		tables.push_back(std::move(table));
+	}
+}
+
+const float* BandlimitedWavetable::getTable(double frequency) const {
+	//Table i has length/2>>i harmonics, so the highest is at frequency*length/2>>i.
+	//Negative frequencies play the table backwards, and alias the same as positive ones.
+	double highest = fabs(frequency)*(bandlimited_wavetable_length/2);
+	double nyquist = sr/2.0;
+	int i = 0;
+	while(i < (int)tables.size()-1 && highest > nyquist) {
+		highest /= 2;
+		i++;
+	}
+	return &tables[i][0];
+}
+
+int BandlimitedWavetable::getTableCount() const {
+	return (int)tables.size();
+}
+
+WavetableOscillator::WavetableOscillator(std::shared_ptr<BandlimitedWavetable> wavetable, float sr): wavetable(wavetable), sr(sr) {
+	table = wavetable->getTable(0.0);
+}
+
+void WavetableOscillator::setFrequency(double frequency) {
+	phase_increment = frequency/sr;
+	table = wavetable->getTable(frequency);
+}
+
+void WavetableOscillator::setPhase(double phase) {
+	this->phase = phase-floor(phase);
+}
+
+double WavetableOscillator::getPhase() {
+	return phase;
+}
+
+void WavetableOscillator::reset() {
+	phase = 0.0;
+}
+
+//One sample at a time, for builds without SSE2 and for whatever doesn't fill a register.
+void wavetableOscillatorSimple(int length, const float* table, double &phase, double phaseIncrement, float* output) {
+	const int tableLength = bandlimited_wavetable_length;
+	for(int i = 0; i < length; i++) {
+		double position = phase*tableLength;
+		int index = (int)position;
+		float fraction = (float)(position-index);
+		index &= tableLength-1;
+		output[i] = table[index]+fraction*(table[index+1]-table[index]);
+		phase += phaseIncrement;
+		phase -= floor(phase);
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+
+void WavetableOscillator::process(int length, float* output) {
+	const int tableLength = bandlimited_wavetable_length;
+	int neededLength = length/4*4;
+	float increment = (float)(phase_increment*tableLength);
+	__m128 offsets = _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(increment));
+	__m128i mask = _mm_set1_epi32(tableLength-1);
+	int indices[4];
+	for(int i = 0; i < neededLength; i += 4) {
+		//Positions are computed in single precision from the double precision phase, so the phase never drifts.
+		__m128 position = _mm_add_ps(_mm_set1_ps((float)(phase*tableLength)), offsets);
+		//Negative frequencies give negative positions, which truncation would round the wrong way.
+		//Floor by subtracting 1 wherever truncation went up: the comparison gives -1 in those lanes.
+		__m128i index = _mm_cvttps_epi32(position);
+		__m128 truncated = _mm_cvtepi32_ps(index);
+		index = _mm_add_epi32(index, _mm_castps_si128(_mm_cmpgt_ps(truncated, position)));
+		__m128 fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+		_mm_storeu_si128((__m128i*)indices, _mm_and_si128(index, mask));
+		__m128 a = _mm_set_ps(table[indices[3]], table[indices[2]], table[indices[1]], table[indices[0]]);
+		__m128 b = _mm_set_ps(table[indices[3]+1], table[indices[2]+1], table[indices[1]+1], table[indices[0]+1]);
+		_mm_storeu_ps(output+i, _mm_add_ps(a, _mm_mul_ps(fraction, _mm_sub_ps(b, a))));
+		phase += 4*phase_increment;
+		phase -= floor(phase);
+	}
+	wavetableOscillatorSimple(length-neededLength, table, phase, phase_increment, output+neededLength);
+}
+
+#else
+
+void WavetableOscillator::process(int length, float* output) {
+	wavetableOscillatorSimple(length, table, phase, phase_increment, output);
+}
+
+#endif
+
+}
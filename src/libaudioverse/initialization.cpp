@@ -11,6 +11,10 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/audio_devices.hpp>
 #include <libaudioverse/private/logging.hpp>
 #include <libaudioverse/private/hrtf.hpp>
+#include <libaudioverse/private/response_cache.hpp>
+#include <libaudioverse/private/sample_cache.hpp>
+#include <libaudioverse/private/wavetable_cache.hpp>
+#include <libaudioverse/private/loader.hpp>
 
 namespace libaudioverse_implementation {
 
@@ -33,6 +37,10 @@ InitInfo initializers[] = {
 	{"Audio backend", initializeDeviceFactory},
 	{"Metadata tables", initializeMetadata},
 	{"HRTF caches", initializeHrtfCaches},
+	{"Impulse response cache", initializeResponseCache},
+	{"Sample cache", initializeSampleCache},
+	{"Wavetable cache", initializeWavetableCache},
+	{"Loader threads", initializeLoader},
 };
 
 typedef void (*shutdownfunc_t)();
@@ -48,11 +56,16 @@ struct ShutdownInfo{
 //Termination never fails.
 //logging must always be last.
 ShutdownInfo shutdown_funcs[] = {
+	//Outstanding loads use everything else, so they have to finish first.
+	{"loader threads", shutdownLoader},
 	{"Error handling subsystem", shutdownErrorModule},
 	{"memory module", shutdownMemoryModule},
 	//Device factory needs to go near the end because it tries to log.
 	{"audio backend", shutdownDeviceFactory},
 	{"HRTF caches", shutdownHrtfCaches},
+	{"impulse response cache", shutdownResponseCache},
+	{"sample cache", shutdownSampleCache},
+	{"wavetable cache", shutdownWavetableCache},
 	{"logging", shutdownLogging},
 };
 
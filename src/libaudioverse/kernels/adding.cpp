@@ -19,6 +19,14 @@ void scalarAdditionKernelSimple(int length, float c, float* a1, float* dest) {
 	for(int i=0; i < length; i++) dest[i]=c+a1[i];
 }
 
+void butterflyKernelSimple(int length, float* a, float* b) {
+	for(int i = 0; i < length; i++) {
+		float sum = a[i]+b[i];
+		b[i] = a[i]-b[i];
+		a[i] = sum;
+	}
+}
+
 #if defined(LIBAUDIOVERSE_USE_SSE2)
 
 void additionKernel(int length, float* a1, float* a2, float* dest) {
@@ -44,6 +52,17 @@ void scalarAdditionKernel(int length, float c, float* a1, float* dest) {
 	scalarAdditionKernelSimple(length-blocks*4, c, a1, dest);
 }
 
+void butterflyKernel(int length, float* a, float* b) {
+	int neededLength = (length/4)*4;
+	for(int i = 0; i < neededLength; i += 4) {
+		__m128 ar = _mm_loadu_ps(a+i);
+		__m128 br = _mm_loadu_ps(b+i);
+		_mm_storeu_ps(a+i, _mm_add_ps(ar, br));
+		_mm_storeu_ps(b+i, _mm_sub_ps(ar, br));
+	}
+	butterflyKernelSimple(length-neededLength, a+neededLength, b+neededLength);
+}
+
 #else
 void additionKernel(int length, float* a1, float* a2, float* dest) {
 	additionKernelSimple(length, a1, a2, dest);
@@ -53,6 +72,10 @@ void scalarAdditionKernel(int length, float c, float* a1, float* dest) {
 	scalarAdditionKernelSimple(length, c, a1, dest);
 }
 
+void butterflyKernel(int length, float* a, float* b) {
+	butterflyKernelSimple(length, a, b);
+}
+
 #endif
 
 
@@ -0,0 +1,199 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**Conversion between float and the compact sample formats buffers can be stored in.
+
+Encoding happens once, when data is loaded, so only decoding has SIMD paths.*/
+#include <libaudioverse/private/kernels.hpp>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <mmintrin.h>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace libaudioverse_implementation {
+
+void floatToInt16Kernel(int length, const float* input, int16_t* output) {
+	for(int i = 0; i < length; i++) {
+		float s = std::min(1.0f, std::max(-1.0f, input[i]));
+		output[i] = (int16_t)(s >= 0.0f ? s*32767.0f+0.5f : s*32767.0f-0.5f);
+	}
+}
+
+void int16ToFloatKernelSimple(int length, const int16_t* input, float* output) {
+	for(int i = 0; i < length; i++) output[i] = input[i]/32767.0f;
+}
+
+//Round-to-nearest-even, with overflow going to infinity; see Fabian Giesen's half conversion notes.
+uint16_t floatToHalf(float f) {
+	uint32_t x;
+	memcpy(&x, &f, 4);
+	uint32_t sign = x&0x80000000u;
+	x ^= sign;
+	uint16_t o;
+	if(x >= 0x47800000u) o = x > 0x7f800000u ? 0x7e00 : 0x7c00; //NaN stays NaN, everything else too big is infinity.
+	else if(x < 0x38800000u) {
+		//Subnormal or zero.  Adding 0.5 lets the FPU do the rounding for us.
+		float fx;
+		memcpy(&fx, &x, 4);
+		fx += 0.5f;
+		uint32_t r;
+		memcpy(&r, &fx, 4);
+		o = (uint16_t)(r-0x3f000000u);
+	}
+	else {
+		uint32_t mantissaOdd = (x>>13)&1;
+		x += 0xc8000fffu; //Rebias the exponent and add the rounding bias.
+		x += mantissaOdd;
+		o = (uint16_t)(x>>13);
+	}
+	return o|(uint16_t)(sign>>16);
+}
+
+void floatToHalfKernel(int length, const float* input, uint16_t* output) {
+	for(int i = 0; i < length; i++) output[i] = floatToHalf(input[i]);
+}
+
+void halfToFloatKernelSimple(int length, const uint16_t* input, float* output) {
+	const float magic = 5.192296858534828e+33f; //2^112.
+	for(int i = 0; i < length; i++) {
+		uint32_t o = (uint32_t)(input[i]&0x7fff)<<13;
+		float f;
+		memcpy(&f, &o, 4);
+		f *= magic;
+		memcpy(&o, &f, 4);
+		if(f >= 65536.0f) o |= 0x7f800000u; //Was infinity or NaN.
+		o |= (uint32_t)(input[i]&0x8000)<<16;
+		memcpy(output+i, &o, 4);
+	}
+}
+
+#if defined(LIBAUDIOVERSE_USE_SSE2)
+void int16ToFloatKernel(int length, const int16_t* input, float* output) {
+	int neededLength = (length/8)*8;
+	__m128 scale = _mm_set1_ps(1.0f/32767.0f);
+	for(int i = 0; i < neededLength; i += 8) {
+		__m128i s = _mm_loadu_si128((const __m128i*)(input+i));
+		//Put each sample in the top half of a 32-bit lane, then shift it back down to sign extend.
+		__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+		_mm_storeu_ps(output+i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(output+i+4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+	int16ToFloatKernelSimple(length-neededLength, input+neededLength, output+neededLength);
+}
+
+void halfToFloatKernel(int length, const uint16_t* input, float* output) {
+	int neededLength = (length/4)*4;
+	__m128i zero = _mm_setzero_si128();
+	__m128i exponentAndMantissa = _mm_set1_epi32(0x7fff);
+	__m128i signBit = _mm_set1_epi32(0x8000);
+	__m128i infNanExponent = _mm_set1_epi32(0x7f800000);
+	__m128 magic = _mm_set1_ps(5.192296858534828e+33f);
+	__m128 wasInfNan = _mm_set1_ps(65536.0f);
+	for(int i = 0; i < neededLength; i += 4) {
+		__m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(input+i)), zero);
+		__m128i sign = _mm_slli_epi32(_mm_and_si128(h, signBit), 16);
+		__m128 f = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, exponentAndMantissa), 13));
+		f = _mm_mul_ps(f, magic);
+		__m128i infNan = _mm_and_si128(_mm_castps_si128(_mm_cmpge_ps(f, wasInfNan)), infNanExponent);
+		__m128i o = _mm_or_si128(_mm_or_si128(_mm_castps_si128(f), infNan), sign);
+		_mm_storeu_ps(output+i, _mm_castsi128_ps(o));
+	}
+	halfToFloatKernelSimple(length-neededLength, input+neededLength, output+neededLength);
+}
+
+#else
+void int16ToFloatKernel(int length, const int16_t* input, float* output) {
+	int16ToFloatKernelSimple(length, input, output);
+}
+
+void halfToFloatKernel(int length, const uint16_t* input, float* output) {
+	halfToFloatKernelSimple(length, input, output);
+}
+#endif
+
+/**IMA ADPCM.
+
+Each block starts with a 4-byte header holding the decoder state (predictor as little-endian int16, then step index, then a pad byte), followed by two samples per byte, low nibble first.
+Since every block carries its own state, any block can be decoded without the ones before it.
+The encoder carries its state across blocks, so block boundaries cost nothing in quality.*/
+
+const int ima_step_table[89] = {
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+const int ima_index_table[16] = {
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+//Advance the decoder state by one nibble, returning the new predictor.
+inline int imaAdpcmStep(int nibble, int &predictor, int &index) {
+	int step = ima_step_table[index];
+	int delta = step>>3;
+	if(nibble&4) delta += step;
+	if(nibble&2) delta += step>>1;
+	if(nibble&1) delta += step>>2;
+	predictor += nibble&8 ? -delta : delta;
+	predictor = std::min(32767, std::max(-32768, predictor));
+	index = std::min(88, std::max(0, index+ima_index_table[nibble]));
+	return predictor;
+}
+
+void imaAdpcmEncodeKernel(int length, const float* input, unsigned char* output) {
+	int predictor = 0, index = 0;
+	int blocks = (length+ima_adpcm_block_frames-1)/ima_adpcm_block_frames;
+	for(int b = 0; b < blocks; b++) {
+		unsigned char* block = output+b*ima_adpcm_block_bytes;
+		block[0] = (unsigned char)(predictor&0xff);
+		block[1] = (unsigned char)((predictor>>8)&0xff);
+		block[2] = (unsigned char)index;
+		block[3] = 0;
+		unsigned char* nibbles = block+4;
+		memset(nibbles, 0, ima_adpcm_block_bytes-4);
+		for(int i = 0; i < ima_adpcm_block_frames; i++) {
+			int frame = b*ima_adpcm_block_frames+i;
+			float s = frame < length ? std::min(1.0f, std::max(-1.0f, input[frame])) : 0.0f;
+			int diff = (int)(s*32767.0f)-predictor;
+			int step = ima_step_table[index];
+			int nibble = 0;
+			if(diff < 0) {
+				nibble = 8;
+				diff = -diff;
+			}
+			if(diff >= step) {
+				nibble |= 4;
+				diff -= step;
+			}
+			if(diff >= step>>1) {
+				nibble |= 2;
+				diff -= step>>1;
+			}
+			if(diff >= step>>2) nibble |= 1;
+			//Track exactly what the decoder will see, so error doesn't accumulate.
+			imaAdpcmStep(nibble, predictor, index);
+			nibbles[i/2] |= (unsigned char)(i%2 ? nibble<<4 : nibble);
+		}
+	}
+}
+
+void imaAdpcmDecodeKernel(const unsigned char* block, int start, int count, float* output) {
+	int predictor = (int16_t)(block[0]|(block[1]<<8));
+	int index = std::min<int>(88, block[2]);
+	const unsigned char* nibbles = block+4;
+	int end = start+count;
+	for(int i = 0; i < end; i++) {
+		int nibble = i%2 ? nibbles[i/2]>>4 : nibbles[i/2]&0x0f;
+		imaAdpcmStep(nibble, predictor, index);
+		if(i >= start) output[i-start] = predictor/32767.0f;
+	}
+}
+
+}
@@ -0,0 +1,70 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**The loader pool, used for decoding and resampling off the simulation lock.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/private/loader.hpp>
+#include <libaudioverse/private/simulation.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <libaudioverse/private/logging.hpp>
+#include <powercores/thread_pool.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <new>
+
+namespace libaudioverse_implementation {
+
+powercores::ThreadPool *loader_pool, *batch_loader_pool;
+//ThreadPool::submitJob isn't safe to call from more than one thread at once.
+std::mutex *loader_mutex;
+
+void initializeLoader() {
+	//Loading is mostly disk and resampling; a couple of threads is plenty, and more would compete with the audio threads.
+	int threads = std::max(1, std::min(2, (int)std::thread::hardware_concurrency()));
+	loader_pool = new powercores::ThreadPool(threads);
+	loader_pool->start();
+	//Batches are meant to use the whole machine.
+	batch_loader_pool = new powercores::ThreadPool(std::max(1, (int)std::thread::hardware_concurrency()));
+	batch_loader_pool->start();
+	loader_mutex = new std::mutex();
+}
+
+void shutdownLoader() {
+	//This joins the threads.
+	delete loader_pool;
+	delete batch_loader_pool;
+	delete loader_mutex;
+}
+
+void submitLoaderJob(std::function<void(void)> job, bool batch) {
+	std::lock_guard<std::mutex> guard(*loader_mutex);
+	if(batch) batch_loader_pool->submitJob(job);
+	else loader_pool->submitJob(job);
+}
+
+void submitAsyncLoad(std::shared_ptr<Simulation> simulation, std::function<void(void)> load, std::function<void(LavError)> callback, bool batch) {
+	submitLoaderJob([=] () {
+		LavError result = Lav_ERROR_NONE;
+		try {
+			load();
+		}
+		catch(ErrorException &e) {
+			recordError(e);
+			result = e.error;
+		}
+		catch(std::bad_alloc &e) {
+			result = Lav_ERROR_MEMORY;
+		}
+		catch(...) {
+			result = Lav_ERROR_UNKNOWN;
+		}
+		if(result != Lav_ERROR_NONE) logInfo("Asynchronous load failed with error %i.", result);
+		if(callback) simulation->enqueueTask([=] () {callback(result);});
+	}, batch);
+}
+
+}
@@ -94,8 +94,14 @@ void Node::tickProperties() {
 }
 
 void Node::tick() {
+	if(beginTick() == false) return;
+	process();
+	endTick();
+}
+
+bool Node::beginTick() {
 	last_processed = simulation->getTickCount();
-	if(getState() == Lav_NODESTATE_PAUSED) return; //nothing to do, for we are paused.
+	if(getState() == Lav_NODESTATE_PAUSED) return false; //nothing to do, for we are paused.
 	//If we're paused, then our output connections short-circuit and add zero.
 	zeroOutputBuffers();
 	tickProperties();
@@ -109,7 +115,10 @@ void Node::tick() {
 	is_processing = true;
 	num_input_buffers = input_buffers.size();
 	num_output_buffers = output_buffers.size();
-	process();
+	return true;
+}
+
+void Node::endTick() {
 	applyMul();
 	applyAdd();
 	is_processing = false;
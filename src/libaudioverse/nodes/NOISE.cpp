@@ -10,34 +10,34 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/macros.hpp>
 #include <libaudioverse/private/memory.hpp>
 #include <libaudioverse/implementations/iir.hpp>
-#include <random>
+#include <libaudioverse/implementations/biquad_bank.hpp>
+#include <libaudioverse/implementations/noise_generator.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <vector>
 
 namespace libaudioverse_implementation {
 
 //we give the random number generator a fixed seed for debugging purposes.
-//Normal distribution with standard deviation 0.25, more than 99% of values are less than 1.
 NoiseNode::NoiseNode(std::shared_ptr<Simulation> simulation): Node(Lav_OBJTYPE_NOISE_NODE, simulation, 0, 1),
-random_number_generator(1234), normal_distribution(0.0f, 0.25f),
-pinkifier(simulation->getSr()),
-brownifier(simulation->getSr()) {
+generator(1234) {
 	/**We have to configure the pinkifier.
 This was originally taken from Spectral Audio processing by JOS.*/
 	//zeros
 	double pinkNumer[] = {0.049922035, -0.095993537, 0.050612699, -0.004408786};
 	//and the poles.
 	double pinkDenom[] = {1, -2.494956002,   2.017265875,  -0.522189400};
-	pinkifier.configure(sizeof(pinkNumer)/sizeof(double), pinkNumer, sizeof(pinkDenom)/sizeof(double), pinkDenom);
+	configureColoring(sizeof(pinkNumer)/sizeof(double), pinkNumer, sizeof(pinkDenom)/sizeof(double), pinkDenom, pink_gain, pink_sections);
 	//this is a butterworth filter designed with the following numpy code:
 	//b, a = butter(1, 0.002)
 	//this is not 100% accurate, but it is doubtful that the error is audible.
 	double brownNumer[] = {0.00313176, 0.00313176};
 	double brownDenom[] = {1.0, -0.99373647};
-	brownifier.configure(sizeof(brownNumer)/sizeof(double), brownNumer, sizeof(brownDenom)/sizeof(double), brownDenom);
+	configureColoring(sizeof(brownNumer)/sizeof(double), brownNumer, sizeof(brownDenom)/sizeof(double), brownDenom, brown_gain, brown_sections);
 	//the pinkifier and brownifier are too quiet, so we bump them up some.
 	//these numbers were obtained by listening to the output and adjusting.
 	//if users need to have the noise on the range-1.0 to 1.0, they can use should_normalize=Truewhich works for all but absurdly small block sizes.
-	pinkifier.setGain(4.0);
-	brownifier.setGain(12.0);
+	pink_gain *= 4.0;
+	brown_gain *= 12.0;
 	appendOutputConnection(0, 1);
 }
 
@@ -45,20 +45,27 @@ std::shared_ptr<Node> createNoiseNode(std::shared_ptr<Simulation> simulation) {
 	return standardNodeCreation<NoiseNode>(simulation);
 }
 
+//The coloring filters are fixed, so they're factored once into second order sections and run as biquad banks.
+void NoiseNode::configureColoring(int numeratorLength, double* numerator, int denominatorLength, double* denominator, double &gain, std::vector<BiquadBank> &sections) {
+	std::vector<IirSection> factored;
+	if(factorIirFilter(numeratorLength, numerator, denominatorLength, denominator, gain, factored) == false) ERROR(Lav_ERROR_INTERNAL, "Could not factor noise coloring filter.");
+	sections.assign(factored.size(), BiquadBank(simulation->getSr(), 1, true));
+	for(unsigned int i = 0; i < factored.size(); i++) sections[i].setCoefficients(0, factored[i].b0, factored[i].b1, factored[i].b2, factored[i].a1, factored[i].a2);
+}
+
+void NoiseNode::color(double gain, std::vector<BiquadBank> &sections) {
+	scalarMultiplicationKernel(block_size, (float)gain, output_buffers[0], output_buffers[0]);
+	for(auto &s: sections) s.process(block_size, &output_buffers[0], &output_buffers[0]);
+}
+
 void NoiseNode::white() {
-	for(int i = 0; i < block_size; i++) {
-		//if this proves too costly, revisit and examine the box-muller method.
-		float noiseSample = 0.0;
-		do {
-			noiseSample = normal_distribution(random_number_generator);
-		} while(noiseSample < -1.0f || noiseSample > 1.0f);
-		output_buffers[0][i] = noiseSample;
-	}
+	//Normal distribution with standard deviation 0.25, truncated to -1 to 1.
+	generator.normal(block_size, output_buffers[0], 0.25f, 1.0f);
 }
 
 void NoiseNode::pink() {
 	white();
-	for(int i = 0; i < block_size; i++) output_buffers[0][i] =pinkifier.tick(output_buffers[0][i]);
+	color(pink_gain, pink_sections);
 	//pass over the output buffer and find the max sample.
 	for(int i = 0; i < block_size; i++) {
 		if(fabs(output_buffers[0][i]) > pink_max) pink_max= fabs(output_buffers[0][i]);
@@ -69,7 +76,7 @@ void NoiseNode::pink() {
 
 void NoiseNode::brown() {
 	white();
-	for(int i= 0; i < block_size; i++) output_buffers[0][i]=brownifier.tick(output_buffers[0][i]);
+	color(brown_gain, brown_sections);
 	//do something to make brown noise here...
 	//pass over the output buffer and find the max sample.
 	for(int i = 0; i < block_size; i++) {
@@ -9,17 +9,17 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/properties.hpp>
 #include <libaudioverse/private/macros.hpp>
 #include <libaudioverse/private/memory.hpp>
-#include <libaudioverse/implementations/biquad.hpp>
-#include <libaudioverse/private/multichannel_filter_bank.hpp>
+#include <libaudioverse/implementations/biquad_bank.hpp>
 #include <memory>
 
 
 namespace libaudioverse_implementation {
 
 BiquadNode::BiquadNode(std::shared_ptr<Simulation> sim, unsigned int channels): Node(Lav_OBJTYPE_BIQUAD_NODE, sim, channels, channels),
-bank(simulation->getSr()) {
+bank(simulation->getSr()), batch_bank(simulation->getSr()) {
 	if(channels < 1) ERROR(Lav_ERROR_RANGE, "Cannot filter 0 or fewer channels.");
-	bank.setChannelCount(channels);
+	bank.setLaneCount(channels);
+	bank.setDoublePrecision(getProperty(Lav_BIQUAD_PRECISION).getIntValue() == Lav_BIQUAD_PRECISION_DOUBLE);
 	prev_type = getProperty(Lav_BIQUAD_FILTER_TYPE).getIntValue();
 	appendInputConnection(0, channels);
 	appendOutputConnection(0, channels);
@@ -35,16 +35,55 @@ void BiquadNode::reconfigure() {
 	float frequency = getProperty(Lav_BIQUAD_FREQUENCY).getFloatValue();
 	float q = getProperty(Lav_BIQUAD_Q).getFloatValue();
 	float dbgain= getProperty(Lav_BIQUAD_DBGAIN).getFloatValue();
-	bank->configure(type, frequency, dbgain, q);
+	bank.configureAll(type, frequency, dbgain, q);
 	if(type != prev_type) bank.reset();
 	prev_type = type;
 }
 
-void BiquadNode::process() {
+void BiquadNode::updateFilter() {
 	if(werePropertiesModified(this, Lav_BIQUAD_FILTER_TYPE, Lav_BIQUAD_DBGAIN, Lav_BIQUAD_FREQUENCY, Lav_BIQUAD_Q)) reconfigure();
+	//Checked directly because sources forward this property.
+	bank.setDoublePrecision(getProperty(Lav_BIQUAD_PRECISION).getIntValue() == Lav_BIQUAD_PRECISION_DOUBLE);
+}
+
+void BiquadNode::process() {
+	updateFilter();
 	bank.process(block_size, &input_buffers[0], &output_buffers[0]);
 }
 
+int BiquadNode::getBatchKey() {
+	if(bank.getLaneCount() != 1) return 0;
+	//Precisions batch separately.
+	//This is asked for before updateFilter runs, so the bank may not have the new precision yet.
+	return getProperty(Lav_BIQUAD_PRECISION).getIntValue() == Lav_BIQUAD_PRECISION_DOUBLE ? 2*Lav_OBJTYPE_BIQUAD_NODE+1 : 2*Lav_OBJTYPE_BIQUAD_NODE;
+}
+
+void BiquadNode::executeBatch(std::shared_ptr<Job>* jobs, int count) {
+	//Gather the filters into one bank, run it, and scatter the history back.
+	//The vectors only allocate when a batch is bigger than any before it.
+	batch_nodes.clear();
+	batch_inputs.clear();
+	batch_outputs.clear();
+	for(int i = 0; i < count; i++) {
+		auto n = static_cast<BiquadNode*>(jobs[i].get());
+		if(n->beginTick() == false) continue;
+		n->updateFilter();
+		batch_nodes.push_back(n);
+		batch_inputs.push_back(n->input_buffers[0]);
+		batch_outputs.push_back(n->output_buffers[0]);
+	}
+	if(batch_nodes.empty()) return;
+	int lanes = batch_nodes.size();
+	batch_bank.setLaneCount(lanes);
+	batch_bank.setDoublePrecision(batch_nodes[0]->bank.getDoublePrecision());
+	for(int i = 0; i < lanes; i++) BiquadBank::copyLane(batch_nodes[i]->bank, 0, batch_bank, i);
+	batch_bank.process(block_size, &batch_inputs[0], &batch_outputs[0]);
+	for(int i = 0; i < lanes; i++) {
+		BiquadBank::copyLane(batch_bank, i, batch_nodes[i]->bank, 0);
+		batch_nodes[i]->endTick();
+	}
+}
+
 void BiquadNode::reset() {
 	bank.reset();
 }
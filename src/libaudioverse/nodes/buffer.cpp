@@ -58,6 +58,7 @@ void BufferNode::process() {
 	if(werePropertiesModified(this, Lav_BUFFER_POSITION)) player.setPosition(getProperty(Lav_BUFFER_POSITION).getDoubleValue());
 	if(werePropertiesModified(this, Lav_BUFFER_RATE)) player.setRate(getProperty(Lav_BUFFER_RATE).getDoubleValue());
 	if(werePropertiesModified(this, Lav_BUFFER_LOOPING)) player.setIsLooping(getProperty(Lav_BUFFER_LOOPING).getIntValue() != 0);
+	if(werePropertiesModified(this, Lav_BUFFER_INTERPOLATION)) player.setInterpolation(getProperty(Lav_BUFFER_INTERPOLATION).getIntValue());
 	int prevEndedCount = player.getEndedCount();
 	player.process(buff->getChannels(), &output_buffers[0]);
 	getProperty(Lav_BUFFER_POSITION).setDoubleValue(player.getPosition());
@@ -13,18 +13,23 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/memory.hpp>
 #include <libaudioverse/private/kernels.hpp>
 #include <libaudioverse/private/buffer.hpp>
-#include <libaudioverse/private/helper_templates.hpp>
 #include <libaudioverse/implementations/buffer_player.hpp>
-#include <iterator>
 #include <vector>
+#include <map>
+#include <stdint.h>
 
 namespace libaudioverse_implementation {
 
+//About 6 seconds at 44100 with a block size of 512.
+const int buffer_timeline_wheel_slots = 512;
+const int buffer_timeline_initial_players = 32;
+
 BufferTimelineNode::BufferTimelineNode(std::shared_ptr<Simulation> simulation, int channels): Node(Lav_OBJTYPE_BUFFER_TIMELINE_NODE, simulation, 0, channels) {
 	if(channels <= 0) ERROR(Lav_ERROR_RANGE, "Channels must be greater than 0.");
 	appendOutputConnection(0, channels);
 	output_channels= channels;
-	for(int i = 0; i < channels; i++) workspace.push_back(allocArray<float>(simulation->getBlockSize()));
+	wheel.resize(buffer_timeline_wheel_slots);
+	for(int i = 0; i < buffer_timeline_initial_players; i++) returnPlayer(getPlayer());
 }
 
 std::shared_ptr<Node> createBufferTimelineNode(std::shared_ptr<Simulation> simulation, int channels) {
@@ -32,37 +37,93 @@ std::shared_ptr<Node> createBufferTimelineNode(std::shared_ptr<Simulation> simul
 }
 
 BufferTimelineNode::~BufferTimelineNode() {
-	for(auto &i: workspace) freeArray(i);
-	for(auto &i: scheduled_buffers) delete i.second;
+	for(auto p: all_players) delete p;
+}
+
+BufferPlayer* BufferTimelineNode::getPlayer() {
+	if(free_players.empty()) {
+		//This only happens when scheduling, never in the audio thread.
+		auto p = new BufferPlayer(simulation->getBlockSize(), simulation->getSr());
+		all_players.push_back(p);
+		//So that moving players between these never allocates.
+		active_players.reserve(all_players.size());
+		free_players.reserve(all_players.size());
+		//A slot can't hold more than every player, so the same goes for moving schedules out of the overflow map.
+		//There are a lot of slots, so they grow by doubling.
+		if(all_players.size() > wheel_slot_capacity) {
+			wheel_slot_capacity = 2*all_players.size();
+			for(auto &slot: wheel) slot.reserve(wheel_slot_capacity);
+		}
+		return p;
+	}
+	auto p = free_players.back();
+	free_players.pop_back();
+	return p;
+}
+
+void BufferTimelineNode::returnPlayer(BufferPlayer* player) {
+	//Releases the buffer's use count.
+	player->setBuffer(nullptr);
+	free_players.push_back(player);
+}
+
+void BufferTimelineNode::addToWheel(ScheduledBufferPlayer scheduled) {
+	if(scheduled.block < block_counter+buffer_timeline_wheel_slots) wheel[scheduled.block%buffer_timeline_wheel_slots].push_back(scheduled);
+	else overflow.insert(std::make_pair(scheduled.block, scheduled));
 }
 
 void BufferTimelineNode::process() {
-	filter(scheduled_buffers, [&](auto &val)->bool {
-		if(val.first > time) return true;
-		if(val.second->getEndedCount()) {
-			delete val.second;
-			return false;
+	if(werePropertiesModified(this, Lav_BUFFER_TIMELINE_INTERPOLATION)) {
+		int interpolation = getProperty(Lav_BUFFER_TIMELINE_INTERPOLATION).getIntValue();
+		for(auto p: all_players) p->setInterpolation(interpolation);
+	}
+	//Players already going.  Finished ones swap with the last and go back to the pool.
+	for(unsigned int i = 0; i < active_players.size();) {
+		auto p = active_players[i];
+		p->process(output_channels, &output_buffers[0], true);
+		if(p->getEndedCount()) {
+			returnPlayer(p);
+			active_players[i] = active_players.back();
+			active_players.pop_back();
 		}
-		//Otherwise, add and keep.
-		val.second->process(output_channels, &workspace[0]);
-		for(int i = 0; i < output_channels; i++) additionKernel(block_size, workspace[i], output_buffers[i], output_buffers[i]);
-		return true;
-	});
-	time+=block_size/simulation->getSr();
+		else i++;
+	}
+	while(overflow.empty() == false && overflow.begin()->first < block_counter+buffer_timeline_wheel_slots) {
+		addToWheel(overflow.begin()->second);
+		overflow.erase(overflow.begin());
+	}
+	//Players starting in this block.
+	auto &slot = wheel[block_counter%buffer_timeline_wheel_slots];
+	for(auto &s: slot) {
+		s.player->process(output_channels, &output_buffers[0], true, s.offset);
+		if(s.player->getEndedCount()) returnPlayer(s.player);
+		else active_players.push_back(s.player);
+	}
+	slot.clear();
+	block_counter++;
 }
 
 void BufferTimelineNode::scheduleBuffer(double time, float delta, std::shared_ptr<Buffer> buffer) {
-	time+=this->time; //time is relative to the node's internal time.
+	//time is relative to the node's internal time.
+	int64_t frame = block_counter*block_size+(int64_t)(time*simulation->getSr()+0.5);
 	//The buffer player handles the buffer's use count.
-	auto player = new BufferPlayer(simulation->getBlockSize(), simulation->getSr());
+	auto player = getPlayer();
 	player->setBuffer(buffer);
+	player->resetEndedCount();
 	player->setRate(delta);
-	scheduled_buffers.insert(decltype(scheduled_buffers)::value_type(time, player));
+	player->setInterpolation(getProperty(Lav_BUFFER_TIMELINE_INTERPOLATION).getIntValue());
+	addToWheel(ScheduledBufferPlayer{player, frame/block_size, (int)(frame%block_size)});
 }
 
 void BufferTimelineNode::reset() {
-	for(auto &i: scheduled_buffers) delete i.second;
-	scheduled_buffers.clear();
+	for(auto p: active_players) returnPlayer(p);
+	active_players.clear();
+	for(auto &slot: wheel) {
+		for(auto &s: slot) returnPlayer(s.player);
+		slot.clear();
+	}
+	for(auto &i: overflow) returnPlayer(i.second.player);
+	overflow.clear();
 }
 
 //begin public API.
@@ -10,6 +10,7 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/macros.hpp>
 #include <libaudioverse/private/memory.hpp>
 #include <libaudioverse/private/dspmath.hpp>
+#include <libaudioverse/private/kernels.hpp>
 #include <libaudioverse/implementations/delayline.hpp>
 #include <libaudioverse/implementations/one_pole_filter.hpp>
 #include <libaudioverse/implementations/interpolated_random_generator.hpp>
@@ -20,6 +21,9 @@ namespace libaudioverse_implementation {
 
 /**This is a reverb based off a householder reflectiona bout the vector [1, 1, 1, 1, 1...].
 We implement the reflection directly in order to avoid needing a full FDN.
+
+Nothing fed back can come out of a line for its delay, so we work in chunks up to the shortest delay, one row per line.
+This gives the same output as going sample by sample.
 */
 
 //constant data
@@ -56,6 +60,8 @@ FdnReverbNode::FdnReverbNode(std::shared_ptr<Simulation> sim): Node(Lav_OBJTYPE_
 		delay_line_modulators[i] = new InterpolatedRandomGenerator(sr, seeds[i]);
 		lowpass_filters[i] = new OnePoleFilter(sr);
 	}
+	line_values = allocArray<float>(8*block_size);
+	feedbacks = allocArray<float>(8*block_size);
 	appendInputConnection(0, 4);
 	appendOutputConnection(0, 4);
 	getProperty(Lav_FDN_REVERB_CUTOFF_FREQUENCY).setFloatRange(0.0f, sr/2.0);
@@ -72,6 +78,8 @@ FdnReverbNode::~FdnReverbNode() {
 	}
 	delete[] delay_lines;
 	delete[] lowpass_filters;
+	freeArray(line_values);
+	freeArray(feedbacks);
 }
 
 void FdnReverbNode::modulateLines() {
@@ -86,39 +94,37 @@ void FdnReverbNode::process() {
 	Lav_FDN_REVERB_DENSITY,
 	Lav_FDN_REVERB_DELAY_MODULATION_FREQUENCY, Lav_FDN_REVERB_DELAY_MODULATION_DEPTH
 	)) reconfigureModel();
-	float lineValues[8];
-	float feedbacks[8];
-	for(int sample = 0; sample < block_size; sample++) {
-		/*Since the vector is [1, 1, 1, 1, 1...] we have already multiplied by it.
-		See https://ccrma.stanford.edu/~jos/pasp/Householder_Feedback_Matrix.html for the formulas we're using heere.
-		In the form we use, a householder matrix has a diagonal of (1-2/n) and a nondiagonal of -2/n.
-		In this algorithm, n is 8.
-		*/
+	for(int start = 0; start < block_size;) {
+		int length = block_size-start;
+		if(needs_modulation) length = std::min(length, modulated_block_limit);
+		else for(int i = 0; i < 8; i++) length = std::min(length, delay_lines[i]->getBlockLimit());
 		//First, read from the lines.
-		for(int i = 0; i < 8; i++) lineValues[i] = delay_lines[i]->computeSample();
+		if(needs_modulation) {
+			for(int k = 0; k < length; k++) {
+				for(int i = 0; i < 8; i++) line_values[i*length+k] = delay_lines[i]->computeSampleAhead(k);
+				modulateLines();
+			}
+		}
+		else for(int i = 0; i < 8; i++) delay_lines[i]->computeBlock(length, line_values+i*length);
 		//The line values are output at this point.
-		for(int i = 0; i < 8; i++) output_buffers[i%4][sample] = lineValues[i];
-		//Do the feedback path.
-		//Sum them to get the value of the row as though it were positive and 2/n all the way across.
-		float lineSum = 0.0f;
-		for(int i = 0; i < 8; i++) lineSum += lineValues[i];
-		lineSum *= 0.25;
-		/**The first row of a householder matrix is:
-		(1-e), -e, -e, -e, -e, -e, -e, -e
-		Where e=2/n.
-		Subsequent rows simply move the (1-e) term.
-		We have the result of the -e vector, essentially, and need only account for the missing 1. Consequently, the following.
-		*/
+		for(int i = 0; i < 8; i++) std::copy(line_values+i*length, line_values+(i+1)*length, output_buffers[i%4]+start);
+		/*Do the feedback path.
+		See https://ccrma.stanford.edu/~jos/pasp/Householder_Feedback_Matrix.html for the formulas we're using heere.
+		In the form we use, a householder matrix has a diagonal of (1-2/n) and a nondiagonal of -2/n.
+		In this algorithm, n is 8.*/
+		std::copy(line_values, line_values+8*length, feedbacks);
+		//The line values aren't needed again, so they double as scratch space.
+		householderReflection(8, length, feedbacks, line_values);
 		for(int i = 0; i < 8; i++) {
-			feedbacks[i] = lineValues[i]-lineSum;
-			feedbacks[i] *= feedback_gains[i];
-			feedbacks[i] = lowpass_filters[i]->tick(feedbacks[i]);
+			float* row = feedbacks+i*length;
+			scalarMultiplicationKernel(length, feedback_gains[i], row, row);
+			auto &filter = *lowpass_filters[i];
+			for(int k = 0; k < length; k++) row[k] = filter.tick(row[k]);
+			//Bring the inputs in to the first four lines.
+			additionKernel(length, row, input_buffers[i%4]+start, row);
+			delay_lines[i]->advanceBlock(length, row);
 		}
-		//Bring the inputs in to the first four lines.
-		for(int i = 0; i < 8; i++) feedbacks[i] += input_buffers[i%4][sample];
-		//Write outputs.
-		for(int i = 0; i < 8; i++) delay_lines[i]->advance(feedbacks[i]);
-		modulateLines();
+		start += length;
 	}
 }
 
@@ -145,6 +151,9 @@ void FdnReverbNode::reconfigureModel() {
 	else {
 		needs_modulation = true;
 		modulation_depth = modDepth*modulation_duration;
+		//The modulators stay within -1 to 1, so no line ever gets shorter than this.
+		float shortest = *std::min_element(current_delays, current_delays+8)-modulation_depth;
+		modulated_block_limit = std::max(1, (int)(shortest*simulation->getSr()));
 		for(int i = 0; i < 8; i++)  delay_line_modulators[i]->setFrequency(modFreq);
 	}
 }
@@ -22,9 +22,9 @@ FeedbackDelayNetworkNode::FeedbackDelayNetworkNode(std::shared_ptr<Simulation> s
 Node(Lav_OBJTYPE_FEEDBACK_DELAY_NETWORK_NODE, simulation, channels, channels) {
 	max_delay = maxDelay;
 	this->channels = channels;
-	network = new FeedbackDelayNetwork<InterpolatedDelayLine>(channels, maxDelay, simulation->getSr());
-	last_output = allocArray<float>(channels);
-	next_input=allocArray<float>(channels);
+	network = new FeedbackDelayNetwork<InterpolatedDelayLine>(channels, maxDelay, simulation->getSr(), simulation->getBlockSize());
+	last_output = allocArray<float>(channels*simulation->getBlockSize());
+	next_input=allocArray<float>(channels*simulation->getBlockSize());
 	gains = allocArray<float>(channels);
 	for(int i = 0; i < channels; i++) gains[i] = 1.0f;
 	getProperty(Lav_FDN_MAX_DELAY).setFloatValue(maxDelay);
@@ -38,34 +38,46 @@ Node(Lav_OBJTYPE_FEEDBACK_DELAY_NETWORK_NODE, simulation, channels, channels) {
 	for(int i = 0; i < channels; i++) filters[i] = new OnePoleFilter(simulation->getSr());
 	
 	
-	std::vector<float> default(channels, 0.0f);
+	std::vector<float> defaults(channels, 0.0f);
 	//Set up the properties.
 	getProperty(Lav_FDN_DELAYS).setArrayLengthRange(channels, channels);
 	getProperty(Lav_FDN_DELAYS).setFloatRange(0.0, maxDelay);
-	getProperty(Lav_FDN_DELAYS).replaceFloatArray(channels, &default[0]);	
-	getProperty(Lav_FDN_DELAYS).setFloatArrayDefault(default);
+	getProperty(Lav_FDN_DELAYS).replaceFloatArray(channels, &defaults[0]);	
+	getProperty(Lav_FDN_DELAYS).setFloatArrayDefault(defaults);
 	
 	getProperty(Lav_FDN_OUTPUT_GAINS).setArrayLengthRange(channels, channels);
 	getProperty(Lav_FDN_OUTPUT_GAINS).setFloatRange(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
-	default.clear();
-	default.resize(channels, 1.0f);
-	getProperty(Lav_FDN_OUTPUT_GAINS).replaceFloatArray(channels, &default[0]);
-	getProperty(Lav_FDN_OUTPUT_GAINS).setFloatArrayDefault(default);
+	defaults.clear();
+	defaults.resize(channels, 1.0f);
+	getProperty(Lav_FDN_OUTPUT_GAINS).replaceFloatArray(channels, &defaults[0]);
+	getProperty(Lav_FDN_OUTPUT_GAINS).setFloatArrayDefault(defaults);
 	//Identity matrix.
-	default.clear();
-	default.resize(channels*channels, 0.0f);
+	defaults.clear();
+	defaults.resize(channels*channels, 0.0f);
 	//Build an identity matrix.
-	for(int i = 0; i < channels; i++) default[i*channels+i] = 0.0f;
+	for(int i = 0; i < channels; i++) defaults[i*channels+i] = 0.0f;
 	getProperty(Lav_FDN_MATRIX).setArrayLengthRange(channels*channels, channels*channels);
 	getProperty(Lav_FDN_MATRIX).setFloatRange(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
-	getProperty(Lav_FDN_MATRIX).replaceFloatArray(channels*channels, &default[0]);
-	getProperty(Lav_FDN_MATRIX).setFloatArrayDefault(default);
+	getProperty(Lav_FDN_MATRIX).replaceFloatArray(channels*channels, &defaults[0]);
+	getProperty(Lav_FDN_MATRIX).setFloatArrayDefault(defaults);
 	
 	//The filters.
 	getProperty(Lav_FDN_FILTER_TYPES).setArrayLengthRange(channels, channels);
 	getProperty(Lav_FDN_FILTER_TYPES).zeroArray(channels);
 	getProperty(Lav_FDN_FILTER_FREQUENCIES).setArrayLengthRange(channels, channels);
 	getProperty(Lav_FDN_FILTER_FREQUENCIES).zeroArray(channels);
+
+	//Structured matrices.
+	bool powerOfTwo = (channels&(channels-1)) == 0;
+	getProperty(Lav_FDN_MATRIX_STRUCTURE).setIntRange(Lav_FDN_MATRIX_STRUCTURE_GENERAL, powerOfTwo ? Lav_FDN_MATRIX_STRUCTURE_HADAMARD : Lav_FDN_MATRIX_STRUCTURE_HOUSEHOLDER);
+	//Structured matrices are orthogonal, so gains of 1 would never decay.
+	defaults.clear();
+	defaults.resize(channels, 0.9f);
+	getProperty(Lav_FDN_FEEDBACK_GAINS).setArrayLengthRange(channels, channels);
+	getProperty(Lav_FDN_FEEDBACK_GAINS).setFloatRange(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+	getProperty(Lav_FDN_FEEDBACK_GAINS).replaceFloatArray(channels, &defaults[0]);
+	getProperty(Lav_FDN_FEEDBACK_GAINS).setFloatArrayDefault(defaults);
+	network->setFeedbackGains(&defaults[0]);
 }
 
 FeedbackDelayNetworkNode::~FeedbackDelayNetworkNode() {
@@ -88,6 +100,12 @@ void FeedbackDelayNetworkNode::process() {
 	if(werePropertiesModified(this, Lav_FDN_MATRIX)) {
 		setMatrix(getProperty(Lav_FDN_MATRIX).getFloatArrayPtr());
 	}
+	if(werePropertiesModified(this, Lav_FDN_MATRIX_STRUCTURE)) {
+		network->setMatrixStructure(getProperty(Lav_FDN_MATRIX_STRUCTURE).getIntValue());
+	}
+	if(werePropertiesModified(this, Lav_FDN_FEEDBACK_GAINS)) {
+		network->setFeedbackGains(getProperty(Lav_FDN_FEEDBACK_GAINS).getFloatArrayPtr());
+	}
 	if(werePropertiesModified(this, Lav_FDN_OUTPUT_GAINS)) {
 		setOutputGains(getProperty(Lav_FDN_OUTPUT_GAINS).getFloatArrayPtr());
 	}
@@ -96,15 +114,20 @@ void FeedbackDelayNetworkNode::process() {
 		getProperty(Lav_FDN_FILTER_TYPES).getIntArrayPtr(),
 		getProperty(Lav_FDN_FILTER_FREQUENCIES).getFloatArrayPtr());
 	}
-	for(int i = 0	; i < block_size; i++) {
-		network->computeFrame(last_output);
-		for(int j = 0; j < num_output_buffers; j++) { 	
-			output_buffers[j][i] = last_output[j]*gains[j];
-			next_input[j] = input_buffers[j][i];
+	//Work in chunks no longer than the shortest delay, so nothing fed back can come out within the chunk.
+	for(int start = 0; start < block_size;) {
+		int length = std::min(network->getBlockLimit(), block_size-start);
+		network->computeBlock(length, last_output);
+		for(int j = 0; j < num_output_buffers; j++) {
+			float* row = last_output+j*length;
+			scalarMultiplicationKernel(length, gains[j], row, output_buffers[j]+start);
+			std::copy(input_buffers[j]+start, input_buffers[j]+start+length, next_input+j*length);
 			//Apply the filter.
-			last_output[j] = filters[j]->tick(last_output[j]);
+			auto &filter = *filters[j];
+			for(int k = 0; k < length; k++) row[k] = filter.tick(row[k]);
 		}
-		network->advance(next_input, last_output);
+		network->advanceBlock(length, next_input, last_output);
+		start += length;
 	}
 }
 
@@ -14,8 +14,11 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/constants.hpp>
 #include <libaudioverse/private/file.hpp>
 #include <libaudioverse/private/kernels.hpp>
+#include <libaudioverse/private/response_cache.hpp>
+#include <libaudioverse/private/loader.hpp>
 #include <libaudioverse/implementations/convolvers.hpp>
 #include <string>
+#include <functional>
 
 namespace libaudioverse_implementation {
 
@@ -46,30 +49,31 @@ void FftConvolverNode::process() {
 void FftConvolverNode::setResponse(int channel, int length, float* response) {
 	if(channel >= channels || channel < 0) ERROR(Lav_ERROR_RANGE, "Channel out of range.");
 	if(length < 1) ERROR(Lav_ERROR_RANGE, "Response must be at least one sample.");
-	convolvers[channel]->setResponse(length, response);
+	convolvers[channel]->setResponseSpectrum(getResponseSpectrum(length, response, simulation->getSr(), simulation->getSr(), simulation->getBlockSize()));
 	convolvers[channel]->reset();
 }
 
 void FftConvolverNode::setResponseFromFile(std::string path, int fileChannel, int convolverChannel) {
+	if(convolverChannel < 0 || convolverChannel >= channels) ERROR(Lav_ERROR_RANGE, "Channel out of range.");
+	//The cache handles reading, resampling, and transforming, and skips the last two if it has seen this response before.
+	auto spectrum = getResponseSpectrumFromFile(path, fileChannel, simulation->getSr(), simulation->getBlockSize());
+	convolvers[convolverChannel]->setResponseSpectrum(spectrum);
+	convolvers[convolverChannel]->reset();
+}
+
+void FftConvolverNode::setResponseFromFileAsync(std::string path, int fileChannel, int convolverChannel, std::function<void(LavError)> callback) {
 	if(convolverChannel < 0 || convolverChannel >= channels) ERROR(Lav_ERROR_RANGE, "Channel out of range.");
 	if(fileChannel < 0) ERROR(Lav_ERROR_RANGE, "File channel must be positive.");
-	FileReader reader{};
-	reader.open(path.c_str());
-	if(fileChannel >= reader.getChannelCount()) ERROR(Lav_ERROR_RANGE, "Channel greater than channels in file.");
-	unsigned int bufferSize= reader.getSampleCount();
-	float* tmp=allocArray<float>(bufferSize);
-	reader.readAll(tmp);
-	//This is a strange trick.  Because we only care about the specified channel, we can kill the others.
-	//Consequently, we copy the channel of interest to the beginning of the buffer.
-	for(int i = 0; i < reader.getFrameCount(); i++) tmp[i] = tmp[i*reader.getChannelCount()+fileChannel];
-	//Resample if needed.
-	float* resampledTmp;
-	int resampledTmpLength;
-	staticResamplerKernel(reader.getSr(), simulation->getSr(), 1, reader.getFrameCount(), tmp, &resampledTmpLength, &resampledTmp);
-	//Finally, set the specified convolver.
-	setResponse(convolverChannel, resampledTmpLength, resampledTmp);
-	freeArray(tmp);
-	delete[] resampledTmp;
+	auto strong = std::static_pointer_cast<FftConvolverNode>(shared_from_this());
+	int sr = (int)simulation->getSr(), blockSize = simulation->getBlockSize();
+	auto load = [strong, path, fileChannel, convolverChannel, sr, blockSize] () {
+		auto spectrum = getResponseSpectrumFromFile(path, fileChannel, sr, blockSize);
+		//Only the swap happens under the lock.
+		LOCK(*strong);
+		strong->convolvers[convolverChannel]->setResponseSpectrum(spectrum);
+		strong->convolvers[convolverChannel]->reset();
+	};
+	submitAsyncLoad(simulation, load, callback);
 }
 
 //begin public api
@@ -99,4 +103,16 @@ Lav_PUBLIC_FUNCTION LavError Lav_fftConvolverNodeSetResponseFromFile(LavHandle n
 	PUB_END
 }
 
+Lav_PUBLIC_FUNCTION LavError Lav_fftConvolverNodeSetResponseFromFileAsync(LavHandle nodeHandle, const char* path, int fileChannel, int convolverChannel, LavAsyncLoadCallback callback, void* userdata) {
+	PUB_BEGIN
+	auto n = incomingObject<FftConvolverNode>(nodeHandle);
+	std::function<void(LavError)> cb;
+	if(callback) cb = [n, callback, userdata] (LavError result) {
+		callback(outgoingObject<Node>(n), result, userdata);
+	};
+	//No lock: the only thing this touches synchronously is immutable.
+	n->setResponseFromFileAsync(path, fileChannel, convolverChannel, cb);
+	PUB_END
+}
+
 }
\ No newline at end of file
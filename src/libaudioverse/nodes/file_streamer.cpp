@@ -0,0 +1,188 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <math.h>
+#include <stdlib.h>
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <libaudioverse/nodes/file_streamer.hpp>
+#include <libaudioverse/private/node.hpp>
+#include <libaudioverse/private/simulation.hpp>
+#include <libaudioverse/private/properties.hpp>
+#include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <libaudioverse/private/logging.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <powercores/utilities.hpp>
+#include <speex_resampler_cpp.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+//How far ahead of playback the background thread decodes.
+const double file_streamer_read_ahead = 0.5;
+//Frames read from the file at once.
+const int file_streamer_chunk_frames = 4096;
+
+int fileStreamerBlockCount(std::shared_ptr<Simulation> simulation) {
+	return std::max(4, (int)ceil(file_streamer_read_ahead*simulation->getSr()/simulation->getBlockSize()));
+}
+
+FileStreamerNode::FileStreamerNode(std::shared_ptr<Simulation> simulation, std::string path): Node(Lav_OBJTYPE_FILE_STREAMER_NODE, simulation, 0, 0),
+filled(fileStreamerBlockCount(simulation)), empty(fileStreamerBlockCount(simulation)) {
+	reader.open(path.c_str());
+	channels = reader.getChannelCount();
+	file_sr = reader.getSr();
+	file_frames = reader.getFrameCount();
+	duration = file_frames/file_sr;
+	resize(0, channels);
+	appendOutputConnection(0, channels);
+	chunk_frames = file_streamer_chunk_frames;
+	chunk = allocArray<float>(chunk_frames*channels);
+	blocks.resize(fileStreamerBlockCount(simulation));
+	for(auto &b: blocks) {
+		b.data = allocArray<float>(channels*simulation->getBlockSize());
+		empty.push(&b);
+	}
+	getProperty(Lav_FILE_STREAMER_POSITION).setDoubleRange(0.0, duration);
+	end_callback = std::make_shared<Callback<void()>>();
+	seekReader(0.0);
+	read_ahead_thread = powercores::safeStartThread(&FileStreamerNode::readAheadThreadFunction, this);
+}
+
+std::shared_ptr<Node> createFileStreamerNode(std::shared_ptr<Simulation> simulation, std::string path) {
+	return standardNodeCreation<FileStreamerNode>(simulation, path);
+}
+
+FileStreamerNode::~FileStreamerNode() {
+	should_stop.store(true);
+	read_ahead_thread.join();
+	for(auto &b: blocks) freeArray(b.data);
+	freeArray(chunk);
+}
+
+void FileStreamerNode::seekReader(double position) {
+	unsigned int frame = std::min((unsigned int)(position*file_sr), file_frames);
+	reader.seek(frame);
+	//A new resampler, so nothing from before the seek leaks through.
+	resampler = speex_resampler_cpp::createResampler(chunk_frames, channels, (int)file_sr, (int)simulation->getSr());
+}
+
+bool FileStreamerNode::feedResampler(int &ended) {
+	unsigned int got = reader.read(chunk_frames, chunk);
+	while(got < (unsigned int)chunk_frames && looping.load()) {
+		reader.seek(0);
+		ended++;
+		unsigned int more = reader.read(chunk_frames-got, chunk+got*channels);
+		if(more == 0) break; //Empty file.
+		got += more;
+	}
+	if(got == 0) return false;
+	std::fill(chunk+got*channels, chunk+chunk_frames*channels, 0.0f);
+	resampler->read(chunk);
+	return true;
+}
+
+void FileStreamerNode::readAheadThreadFunction() {
+	int generation = 0;
+	double position = 0.0, sr = simulation->getSr();
+	int blockSize = simulation->getBlockSize();
+	//Set at the end of a non-looping file, until the next seek.
+	bool finished = false;
+	try {
+		while(should_stop.load() == false) {
+			int wantedGeneration = seek_generation.load(std::memory_order_acquire);
+			if(wantedGeneration != generation) {
+				generation = wantedGeneration;
+				position = seek_position.load();
+				seekReader(position);
+				finished = false;
+			}
+			StreamedBlock* block;
+			if(finished || empty.pop(block) == false) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				continue;
+			}
+			int got = 0, ended = 0;
+			while(got < blockSize) {
+				got += resampler->write(block->data+got*channels, blockSize-got);
+				if(got < blockSize && feedResampler(ended) == false) {
+					std::fill(block->data+got*channels, block->data+blockSize*channels, 0.0f);
+					ended++;
+					finished = true;
+					break;
+				}
+			}
+			block->generation = generation;
+			block->position = position;
+			block->ended = ended;
+			position += blockSize/sr;
+			if(looping.load() && duration > 0.0) position = fmod(position, duration);
+			else position = std::min(position, duration);
+			//There are only as many blocks as the rings hold, so this can't fail.
+			filled.push(block);
+		}
+	}
+	catch(ErrorException &e) {
+		logInfo("File streamer read-ahead thread stopped: %s", e.message.c_str());
+	}
+	catch(...) {
+		logInfo("File streamer read-ahead thread stopped because of an unknown exception.");
+	}
+}
+
+void FileStreamerNode::process() {
+	if(werePropertiesModified(this, Lav_FILE_STREAMER_LOOPING)) looping.store(getProperty(Lav_FILE_STREAMER_LOOPING).getIntValue() != 0);
+	if(werePropertiesModified(this, Lav_FILE_STREAMER_POSITION)) {
+		seek_position.store(getProperty(Lav_FILE_STREAMER_POSITION).getDoubleValue());
+		current_generation++;
+		seek_generation.store(current_generation, std::memory_order_release);
+	}
+	StreamedBlock* block;
+	bool haveBlock = false;
+	while(filled.pop(block)) {
+		if(block->generation == current_generation) {
+			haveBlock = true;
+			break;
+		}
+		//From before a seek.
+		empty.push(block);
+	}
+	//Either an underrun or we're past the end. Our outputs are already zeroed.
+	if(haveBlock == false) return;
+	uninterleaveSamples(channels, block_size, block->data, channels, &output_buffers[0]);
+	getProperty(Lav_FILE_STREAMER_POSITION).setDoubleValue(block->position);
+	if(block->ended) {
+		auto &endedCount = getProperty(Lav_FILE_STREAMER_ENDED_COUNT);
+		endedCount.setIntValue(endedCount.getIntValue()+block->ended);
+		for(int i = 0; i < block->ended; i++) simulation->enqueueTask([=] () {(*end_callback)();});
+	}
+	empty.push(block);
+}
+
+//begin public api
+
+Lav_PUBLIC_FUNCTION LavError Lav_createFileStreamerNode(LavHandle simulationHandle, const char* path, LavHandle* destination) {
+	PUB_BEGIN
+	auto simulation = incomingObject<Simulation>(simulationHandle);
+	LOCK(*simulation);
+	auto retval = createFileStreamerNode(simulation, path);
+	*destination = outgoingObject<Node>(retval);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_fileStreamerNodeSetEndCallback(LavHandle nodeHandle, LavParameterlessCallback callback, void* userdata) {
+	PUB_BEGIN
+	auto n = incomingObject<FileStreamerNode>(nodeHandle);
+	if(callback) {
+		n->end_callback->setCallback(wrapParameterlessCallback(n, callback, userdata));
+	}
+	else n->end_callback->clear();
+	PUB_END
+}
+
+}
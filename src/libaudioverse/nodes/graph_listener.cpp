@@ -15,7 +15,8 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 
 namespace libaudioverse_implementation {
 
-GraphListenerNode::GraphListenerNode(std::shared_ptr<Simulation> sim, unsigned int channels): Node(Lav_OBJTYPE_GRAPH_LISTENER_NODE, sim, channels, channels) {
+GraphListenerNode::GraphListenerNode(std::shared_ptr<Simulation> sim, unsigned int channels): Node(Lav_OBJTYPE_GRAPH_LISTENER_NODE, sim, channels, channels),
+tap(std::max<unsigned int>((unsigned int)sim->getSr(), 4*sim->getBlockSize())*channels) {
 	outgoing_buffer = allocArray<float>(channels*sim->getBlockSize());
 	this->channels = channels;
 	appendInputConnection(0, channels);
@@ -31,17 +32,24 @@ GraphListenerNode::~GraphListenerNode() {
 }
 
 void GraphListenerNode::process() {
-	if(callback) {
-		for(int i = 0; i < block_size; i++) {
-			for(unsigned int j = 0; j < channels; j++) {
-				outgoing_buffer[i*channels+j] = input_buffers[j][i];
-			}
+	bool tapping = getProperty(Lav_GRAPH_LISTENER_TAP_ENABLED).getIntValue() == 1;
+	if(callback || tapping) interleaveSamples(channels, block_size, channels, &input_buffers[0], outgoing_buffer);
+	if(callback) callback(outgoingObject(this->shared_from_this()), block_size, channels, outgoing_buffer, callback_userdata);
+	if(tapping) {
+		//Only whole blocks go in, so readers always see whole frames.
+		if(tap.getCapacity()-tap.size() >= block_size*channels) tap.write(outgoing_buffer, block_size*channels);
+		else {
+			auto &overruns = getProperty(Lav_GRAPH_LISTENER_TAP_OVERRUNS);
+			overruns.setIntValue(overruns.getIntValue()+1);
 		}
-		callback(outgoingObject(this->shared_from_this()), block_size, channels, outgoing_buffer, callback_userdata);
 	}
 	for(int i= 0; i < num_output_buffers; i++) std::copy(input_buffers[i], input_buffers[i]+block_size, output_buffers[i]);
 }
 
+unsigned int GraphListenerNode::readTap(unsigned int frames, float* destination) {
+	return tap.read(destination, frames*channels)/channels;
+}
+
 //begin public api
 
 Lav_PUBLIC_FUNCTION LavError Lav_createGraphListenerNode(LavHandle simulationHandle, unsigned int channels, LavHandle* destination) {
@@ -63,4 +71,13 @@ Lav_PUBLIC_FUNCTION LavError Lav_graphListenerNodeSetListeningCallback(LavHandle
 	PUB_END
 }
 
+Lav_PUBLIC_FUNCTION LavError Lav_graphListenerNodeReadTap(LavHandle nodeHandle, unsigned int frames, float* destination, unsigned int* framesRead) {
+	PUB_BEGIN
+	auto node = incomingObject<Node>(nodeHandle);
+	//No lock: reading the tap is lock-free.
+	if(node->getType() != Lav_OBJTYPE_GRAPH_LISTENER_NODE) ERROR(Lav_ERROR_TYPE_MISMATCH, "Expected a graph listener.");
+	*framesRead = std::static_pointer_cast<GraphListenerNode>(node)->readTap(frames, destination);
+	PUB_END
+}
+
 }
\ No newline at end of file
@@ -11,6 +11,11 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/macros.hpp>
 #include <libaudioverse/private/memory.hpp>
 #include <libaudioverse/implementations/iir.hpp>
+#include <libaudioverse/implementations/biquad_bank.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <vector>
+#include <utility>
+#include <math.h>
 
 namespace libaudioverse_implementation {
 
@@ -36,17 +41,71 @@ IirNode::~IirNode() {
 }
 
 void IirNode::process() {
+	if(use_sections) {
+		for(int i = 0; i < channels; i++) scalarMultiplicationKernel(block_size, (float)section_gain, input_buffers[i], output_buffers[i]);
+		for(auto &s: sections) s.process(block_size, &output_buffers[0], &output_buffers[0]);
+		return;
+	}
 	for(unsigned int i = 0; i < channels; i++) {
 		auto &f = *filters[i];
 		for(int j = 0; j < block_size; j++) output_buffers[i][j] = f.tick(input_buffers[i][j]);
 	}
 }
 
+//Poles further apart than this are taken to be different poles when deciding whether a section's history carries over.
+const double section_matching_tolerance = 0.05;
+
+bool isZeroPolynomial(int length, double* coefficients) {
+	for(int i = 0; i < length; i++) if(coefficients[i] != 0.0) return false;
+	return true;
+}
+
 void IirNode::setCoefficients(int numeratorLength, double* numerator, int denominatorLength, double* denominator, int shouldClearHistory) {
+	if(numeratorLength <= 0 || denominatorLength <= 0) ERROR(Lav_ERROR_RANGE, "Both numerator and denominator must have nonzero length.");
+	if(isZeroPolynomial(numeratorLength, numerator) || isZeroPolynomial(denominatorLength, denominator)) ERROR(Lav_ERROR_RANGE, "Numerator and denominator may not be all zeros.");
+	//The direct form would reject this too, but only after we'd given up the sections.
+	if(denominator[0] == 0.0) ERROR(Lav_ERROR_RANGE, "The first coefficient of the denominator must be nonzero.");
+	std::vector<IirSection> factored;
+	double gain;
+	if(factorIirFilter(numeratorLength, numerator, denominatorLength, denominator, gain, factored)) {
+		//The factorization doesn't promise any particular order of sections, so a section only keeps its history if it is near a pole pair we were already running.
+		//This keeps sweeping coefficients smooth without handing one pole pair's state to another.
+		std::vector<BiquadBank> newSections;
+		std::vector<bool> used(sections.size(), false);
+		bool keepHistory = use_sections && shouldClearHistory == 0;
+		for(auto &f: factored) {
+			int nearest = -1;
+			double nearestDistance = section_matching_tolerance;
+			for(unsigned int i = 0; keepHistory && i < sections.size(); i++) {
+				if(used[i]) continue;
+				double distance = fabs(f.a1-section_poles[i].a1)+fabs(f.a2-section_poles[i].a2);
+				if(distance <= nearestDistance) {
+					nearest = i;
+					nearestDistance = distance;
+				}
+			}
+			if(nearest == -1) newSections.emplace_back(simulation->getSr(), channels, true);
+			else {
+				used[nearest] = true;
+				newSections.push_back(std::move(sections[nearest]));
+			}
+			for(int j = 0; j < channels; j++) newSections.back().setCoefficients(j, f.b0, f.b1, f.b2, f.a1, f.a2);
+		}
+		sections = std::move(newSections);
+		section_poles = factored;
+		section_gain = gain;
+		use_sections = true;
+		return;
+	}
+	//The direct form histories are stale if we were using sections.
+	if(use_sections) shouldClearHistory = 1;
 	for(int i =0; i < channels; i++) {
 		filters[i]->configure(numeratorLength, numerator, denominatorLength, denominator);
 		if(shouldClearHistory !=0) filters[i]->clearHistories();
 	}
+	use_sections = false;
+	sections.clear();
+	section_poles.clear();
 }
 
 //begin public api
@@ -0,0 +1,104 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <math.h>
+#include <stdlib.h>
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <libaudioverse/nodes/matrix_convolver.hpp>
+#include <libaudioverse/private/node.hpp>
+#include <libaudioverse/private/simulation.hpp>
+#include <libaudioverse/private/properties.hpp>
+#include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/constants.hpp>
+#include <libaudioverse/private/file.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <libaudioverse/implementations/convolvers.hpp>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+MatrixConvolverNode::MatrixConvolverNode(std::shared_ptr<Simulation> simulation, int inputChannels, int outputChannels): Node(Lav_OBJTYPE_MATRIX_CONVOLVER_NODE, simulation, inputChannels, outputChannels) {
+	if(inputChannels < 1 || outputChannels < 1) ERROR(Lav_ERROR_RANGE, "Channels must be greater than 0.");
+	appendInputConnection(0, inputChannels);
+	appendOutputConnection(0, outputChannels);
+	input_channels = inputChannels;
+	output_channels = outputChannels;
+	convolver = new FftMatrixConvolver(simulation->getBlockSize(), inputChannels, outputChannels);
+}
+
+std::shared_ptr<Node> createMatrixConvolverNode(std::shared_ptr<Simulation> simulation, int inputChannels, int outputChannels) {
+	return standardNodeCreation<MatrixConvolverNode>(simulation, inputChannels, outputChannels);
+}
+
+MatrixConvolverNode::~MatrixConvolverNode() {
+	delete convolver;
+}
+
+void MatrixConvolverNode::process() {
+	convolver->convolve(&input_buffers[0], &output_buffers[0]);
+}
+
+void MatrixConvolverNode::reset() {
+	convolver->reset();
+}
+
+void MatrixConvolverNode::setResponse(int inputChannel, int outputChannel, int length, float* response) {
+	if(inputChannel < 0 || inputChannel >= input_channels) ERROR(Lav_ERROR_RANGE, "Input channel out of range.");
+	if(outputChannel < 0 || outputChannel >= output_channels) ERROR(Lav_ERROR_RANGE, "Output channel out of range.");
+	if(length < 0) ERROR(Lav_ERROR_RANGE, "Length must not be negative.");
+	convolver->setResponse(inputChannel, outputChannel, length, response);
+}
+
+void MatrixConvolverNode::setResponseFromFile(std::string path, int fileChannel, int inputChannel, int outputChannel) {
+	if(inputChannel < 0 || inputChannel >= input_channels) ERROR(Lav_ERROR_RANGE, "Input channel out of range.");
+	if(outputChannel < 0 || outputChannel >= output_channels) ERROR(Lav_ERROR_RANGE, "Output channel out of range.");
+	if(fileChannel < 0) ERROR(Lav_ERROR_RANGE, "File channel must be positive.");
+	FileReader reader{};
+	reader.open(path.c_str());
+	if(fileChannel >= reader.getChannelCount()) ERROR(Lav_ERROR_RANGE, "Channel greater than channels in file.");
+	unsigned int bufferSize= reader.getSampleCount();
+	float* tmp=allocArray<float>(bufferSize);
+	reader.readAll(tmp);
+	//Pull the channel of interest to the front, as FftConvolverNode does.
+	for(int i = 0; i < reader.getFrameCount(); i++) tmp[i] = tmp[i*reader.getChannelCount()+fileChannel];
+	float* resampledTmp;
+	int resampledTmpLength;
+	staticResamplerKernel(reader.getSr(), simulation->getSr(), 1, reader.getFrameCount(), tmp, &resampledTmpLength, &resampledTmp);
+	setResponse(inputChannel, outputChannel, resampledTmpLength, resampledTmp);
+	freeArray(tmp);
+	delete[] resampledTmp;
+}
+
+//begin public api
+
+Lav_PUBLIC_FUNCTION LavError Lav_createMatrixConvolverNode(LavHandle simulationHandle, int inputChannels, int outputChannels, LavHandle* destination) {
+	PUB_BEGIN
+	auto simulation = incomingObject<Simulation>(simulationHandle);
+	LOCK(*simulation);
+	auto retval = createMatrixConvolverNode(simulation, inputChannels, outputChannels);
+	*destination = outgoingObject<Node>(retval);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_matrixConvolverNodeSetResponse(LavHandle nodeHandle, int inputChannel, int outputChannel, int length, float* response) {
+	PUB_BEGIN
+	if(length < 0) ERROR(Lav_ERROR_RANGE, "Length must not be negative.");
+	if(length > 0 && response == nullptr) ERROR(Lav_ERROR_NULL_POINTER);
+	auto n = incomingObject<MatrixConvolverNode>(nodeHandle);
+	LOCK(*n);
+	n->setResponse(inputChannel, outputChannel, length, response);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_matrixConvolverNodeSetResponseFromFile(LavHandle nodeHandle, const char* path, int fileChannel, int inputChannel, int outputChannel) {
+	PUB_BEGIN
+	if(path == nullptr) ERROR(Lav_ERROR_NULL_POINTER);
+	auto n = incomingObject<MatrixConvolverNode>(nodeHandle);
+	LOCK(*n);
+	n->setResponseFromFile(path, fileChannel, inputChannel, outputChannel);
+	PUB_END
+}
+
+}
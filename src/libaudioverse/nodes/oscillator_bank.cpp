@@ -0,0 +1,84 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <libaudioverse/nodes/oscillator_bank.hpp>
+#include <libaudioverse/private/node.hpp>
+#include <libaudioverse/private/simulation.hpp>
+#include <libaudioverse/private/properties.hpp>
+#include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/implementations/sin_osc_bank.hpp>
+#include <vector>
+#include <limits>
+
+namespace libaudioverse_implementation {
+
+OscillatorBankNode::OscillatorBankNode(std::shared_ptr<Simulation> simulation, int oscillators): Node(Lav_OBJTYPE_OSCILLATOR_BANK_NODE, simulation, 0, 1),
+bank(simulation->getSr(), oscillators), oscillators(oscillators) {
+	appendOutputConnection(0, 1);
+	std::vector<float> defaults(oscillators, 0.0f);
+	getProperty(Lav_OSCILLATOR_BANK_FREQUENCIES).setArrayLengthRange(oscillators, oscillators);
+	getProperty(Lav_OSCILLATOR_BANK_FREQUENCIES).setFloatRange(0.0f, std::numeric_limits<float>::infinity());
+	getProperty(Lav_OSCILLATOR_BANK_FREQUENCIES).replaceFloatArray(oscillators, &defaults[0]);
+	getProperty(Lav_OSCILLATOR_BANK_FREQUENCIES).setFloatArrayDefault(defaults);
+	getProperty(Lav_OSCILLATOR_BANK_PHASES).setArrayLengthRange(oscillators, oscillators);
+	getProperty(Lav_OSCILLATOR_BANK_PHASES).setFloatRange(0.0f, 1.0f);
+	getProperty(Lav_OSCILLATOR_BANK_PHASES).replaceFloatArray(oscillators, &defaults[0]);
+	getProperty(Lav_OSCILLATOR_BANK_PHASES).setFloatArrayDefault(defaults);
+	defaults.clear();
+	defaults.resize(oscillators, 1.0f);
+	getProperty(Lav_OSCILLATOR_BANK_AMPLITUDES).setArrayLengthRange(oscillators, oscillators);
+	getProperty(Lav_OSCILLATOR_BANK_AMPLITUDES).setFloatRange(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+	getProperty(Lav_OSCILLATOR_BANK_AMPLITUDES).replaceFloatArray(oscillators, &defaults[0]);
+	getProperty(Lav_OSCILLATOR_BANK_AMPLITUDES).setFloatArrayDefault(defaults);
+	reconfigureFrequencies();
+	reconfigureAmplitudes();
+}
+
+std::shared_ptr<Node> createOscillatorBankNode(std::shared_ptr<Simulation> simulation, int oscillators) {
+	if(oscillators < 1) ERROR(Lav_ERROR_RANGE, "Must have at least one oscillator.");
+	return standardNodeCreation<OscillatorBankNode>(simulation, oscillators);
+}
+
+void OscillatorBankNode::reconfigureFrequencies() {
+	float* frequencies = getProperty(Lav_OSCILLATOR_BANK_FREQUENCIES).getFloatArrayPtr();
+	float multiplier = getProperty(Lav_OSCILLATOR_FREQUENCY_MULTIPLIER).getFloatValue();
+	for(int i = 0; i < oscillators; i++) bank.setFrequency(i, frequencies[i]*multiplier);
+}
+
+void OscillatorBankNode::reconfigureAmplitudes() {
+	float* amplitudes = getProperty(Lav_OSCILLATOR_BANK_AMPLITUDES).getFloatArrayPtr();
+	for(int i = 0; i < oscillators; i++) bank.setAmplitude(i, amplitudes[i]);
+}
+
+void OscillatorBankNode::reconfigurePhases() {
+	float* phases = getProperty(Lav_OSCILLATOR_BANK_PHASES).getFloatArrayPtr();
+	for(int i = 0; i < oscillators; i++) bank.setPhase(i, phases[i]);
+}
+
+void OscillatorBankNode::process() {
+	if(werePropertiesModified(this, Lav_OSCILLATOR_BANK_FREQUENCIES, Lav_OSCILLATOR_FREQUENCY_MULTIPLIER)) reconfigureFrequencies();
+	if(werePropertiesModified(this, Lav_OSCILLATOR_BANK_AMPLITUDES)) reconfigureAmplitudes();
+	if(werePropertiesModified(this, Lav_OSCILLATOR_BANK_PHASES)) reconfigurePhases();
+	bank.process(block_size, output_buffers[0]);
+}
+
+void OscillatorBankNode::reset() {
+	bank.reset();
+	reconfigurePhases();
+}
+
+//begin public api
+
+Lav_PUBLIC_FUNCTION LavError Lav_createOscillatorBankNode(LavHandle simulationHandle, int oscillators, LavHandle* destination) {
+	PUB_BEGIN
+	auto simulation = incomingObject<Simulation>(simulationHandle);
+	LOCK(*simulation);
+	auto retval = createOscillatorBankNode(simulation, oscillators);
+	*destination = outgoingObject<Node>(retval);
+	PUB_END
+}
+
+}
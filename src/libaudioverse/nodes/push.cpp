@@ -9,12 +9,16 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/properties.hpp>
 #include <libaudioverse/private/macros.hpp>
 #include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/kernels.hpp>
 #include <speex_resampler_cpp.hpp>
+#include <algorithm>
 #include <memory>
 
 namespace libaudioverse_implementation {
 
-PushNode::PushNode(std::shared_ptr<Simulation> sim, unsigned int inputSr, unsigned int channels): Node(Lav_OBJTYPE_PUSH_NODE, sim, 0, channels) {
+PushNode::PushNode(std::shared_ptr<Simulation> sim, unsigned int inputSr, unsigned int channels): Node(Lav_OBJTYPE_PUSH_NODE, sim, 0, channels),
+//At least 2 seconds of audio can be waiting to play.
+fed(std::max(2*inputSr, 4096u)*std::max(channels, 1u)) {
 	if(channels == 0) ERROR(Lav_ERROR_RANGE, "Channels must be greater than 0.");
 	input_sr = inputSr;
 	resampler = speex_resampler_cpp::createResampler(push_frames, channels, inputSr, (int)sim->getSr());
@@ -34,9 +38,21 @@ PushNode::~PushNode() {
 }
 
 void PushNode::process() {
+	//Give the resampler whole chunks of fed audio until it has enough for this block.
+	while(resampler->estimateAvailableFrames() < block_size) {
+		unsigned int wanted = (push_frames-push_offset)*push_channels;
+		unsigned int got = fed.read(push_buffer+push_offset*push_channels, wanted);
+		push_offset += got/push_channels;
+		if(got) fired_underrun_callback = false;
+		if(got < wanted) break;
+		resampler->read(push_buffer);
+		push_offset = 0;
+	}
 	memset(workspace, 0, sizeof(float)*push_channels*block_size);
 	unsigned int got = resampler->write(workspace, simulation->getBlockSize());
 	if(got < simulation->getBlockSize()) {
+		//Flush whatever partial chunk we have, padded with silence.
+		memset(push_buffer+push_offset*push_channels, 0, sizeof(float)*push_channels*(push_frames-push_offset));
 		resampler->read(push_buffer);
 		memset(push_buffer, 0, sizeof(float)*push_channels*push_frames);
 		push_offset = 0;
@@ -46,33 +62,23 @@ void PushNode::process() {
 			fired_underrun_callback = true;
 		}
 	}
-	for(unsigned int i = 0; i < push_channels*block_size; i++) {
-		unsigned int output = i%push_channels;
-		unsigned int position = i/push_channels;
-		output_buffers[output][position] = workspace[i];
-	}
+	uninterleaveSamples(push_channels, block_size, workspace, push_channels, &output_buffers[0]);
+	int dropped = (int)dropped_frames.load(std::memory_order_relaxed);
+	if(getProperty(Lav_PUSH_DROPPED_FRAMES).getIntValue() != dropped) getProperty(Lav_PUSH_DROPPED_FRAMES).setIntValue(dropped);
 	float threshold = getProperty(Lav_PUSH_THRESHOLD).getFloatValue();
-	float remaining = resampler->estimateAvailableFrames()/(float)simulation->getSr();
+	float remaining = resampler->estimateAvailableFrames()/(float)simulation->getSr()+(fed.size()/push_channels+push_offset)/(float)input_sr;
 	if(remaining < threshold && fired_underrun_callback == false) {
 		simulation->enqueueTask([=] () {(*low_callback)();});
 	}
 }
 
 void PushNode::feed(unsigned int length, float* buffer) {
-	fired_underrun_callback = false;
 	if(length%push_channels != 0) ERROR(Lav_ERROR_RANGE, "Length must be a multiple of the configured channels.");
-	unsigned int frames = length/push_channels;
-	unsigned int offset = 0;
-	while(offset < frames) {
-		if(push_offset == push_frames) {
-			resampler->read(push_buffer);
-			push_offset = 0;
-			memset(push_buffer, 0, sizeof(float)*push_frames*push_channels);
-		}
-		for(unsigned int i = 0; i < push_channels; i++) push_buffer[push_offset*push_channels+i] = buffer[offset*push_channels+i];
-		offset ++;
-		push_offset ++;
-	}
+	//Only write whole frames, so that process always reads whole frames.
+	unsigned int space = fed.getCapacity()-fed.size();
+	space -= space%push_channels;
+	unsigned int written = fed.write(buffer, std::min(length, space));
+	if(written < length) dropped_frames.fetch_add((length-written)/push_channels, std::memory_order_relaxed);
 }
 
 //begin public api.
@@ -88,7 +94,7 @@ Lav_PUBLIC_FUNCTION LavError Lav_createPushNode(LavHandle simulationHandle, unsi
 Lav_PUBLIC_FUNCTION LavError Lav_pushNodeFeed(LavHandle nodeHandle, unsigned int length, float* buffer) {
 	PUB_BEGIN
 	auto node=incomingObject<Node>(nodeHandle);
-	LOCK(*node);
+	//No lock: feeding is lock-free.
 	if(node->getType() != Lav_OBJTYPE_PUSH_NODE) ERROR(Lav_ERROR_TYPE_MISMATCH, "Expected a push node.");
 	std::static_pointer_cast<PushNode>(node)->feed(length, buffer);
 	PUB_END
@@ -13,11 +13,11 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <libaudioverse/private/constants.hpp>
 #include <libaudioverse/private/file.hpp>
 #include <libaudioverse/private/kernels.hpp>
-#include <powercores/threadsafe_queue.hpp>
-#include <powercores/exceptions.hpp>
 #include <powercores/utilities.hpp>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
 #include <thread>
-#include <mutex>
 #include <atomic>
 
 namespace libaudioverse_implementation {
@@ -26,36 +26,44 @@ RecorderNode::RecorderNode(std::shared_ptr<Simulation> simulation, int channels)
 	appendInputConnection(0, channels);
 	appendOutputConnection(0, channels);
 	this->channels = channels;
-	buffer_size=simulation->getBlockSize()*channels;
-	//allocate a few buffers.
-	for(int i=0; i < 5; i++) available_buffers.enqueue(allocArray<float>(buffer_size));
 }
 
 std::shared_ptr<Node> createRecorderNode(std::shared_ptr<Simulation> simulation, int channels) {
-	auto ret = standardNodeCreation<RecorderNode>(simulation, channels);
-	simulation->registerNodeForMaintenance(ret);
-	return ret;
+	return standardNodeCreation<RecorderNode>(simulation, channels);
 }
 
 RecorderNode::~RecorderNode() {
 	stopRecording();
-	while(available_buffers.size()) freeArray(available_buffers.dequeue());
-	while(unwritten_buffers.size()) freeArray(unwritten_buffers.dequeue());
 }
 
 void RecorderNode::recordingThreadFunction() {
+	int blockSamples = block_size*channels;
+	//Sleeping for a quarter of the ring means we usually find several blocks to write at once, without getting close to overflowing.
+	double ringDuration = ring_blocks*block_size/simulation->getSr();
+	auto pollInterval = std::chrono::milliseconds(std::min(50, std::max(1, (int)(ringDuration*1000/4))));
 	try { //If we get an error that gets all the way out to here, we need to abort the thread without terminating the ap.
-		while(should_keep_recording.test_and_set()) {
-			float* buffer= nullptr;
-			try {
-				buffer = unwritten_buffers.dequeueWithTimeout(5);
+		while(true) {
+			//Check this first: once it's false, nothing else is coming, so an empty ring means we're done.
+			bool stopping = should_keep_recording.load() == false;
+			unsigned int read = blocks_read.load(std::memory_order_relaxed);
+			unsigned int available = blocks_written.load(std::memory_order_acquire)-read;
+			if(available == 0) {
+				if(stopping) break;
+				std::this_thread::sleep_for(pollInterval);
+				continue;
 			}
-			catch(powercores::TimeoutException e) {
-				continue; //try again in  a bit, if no one has cleared the flag.
+			//Everything up to the end of the ring is contiguous.
+			unsigned int start = read%ring_blocks;
+			unsigned int count = std::min(available, ring_blocks-start);
+			float* data = ring+start*blockSamples;
+			int frames = 0, total = count*block_size;
+			while(frames != total) {
+				int got = recording_to.write(total-frames, data+frames*channels);
+				//A write that makes no progress never will; give up on the file and let the audio thread count the dropped blocks.
+				if(got <= 0) ERROR(Lav_ERROR_FILE, "Could not write to the recording.");
+				frames += got;
 			}
-			int frames= 0;
-			while(frames != block_size) frames += recording_to.write(block_size-frames, buffer+frames*channels);
-			available_buffers.enqueue(buffer);
+			blocks_read.store(read+count, std::memory_order_release);
 		}
 	}
 	catch(...) {
@@ -66,32 +74,41 @@ void RecorderNode::recordingThreadFunction() {
 
 void RecorderNode::process() {
 	if(recording) {
-		float* buffer;
-		if(available_buffers.size()) buffer = available_buffers.dequeue();
-		else buffer =allocArray<float>(buffer_size);
-		interleaveSamples(num_input_buffers, block_size, num_input_buffers, &input_buffers[0], buffer);
-		unwritten_buffers.enqueue(buffer);
+		unsigned int written = blocks_written.load(std::memory_order_relaxed);
+		if(written-blocks_read.load(std::memory_order_acquire) >= ring_blocks) {
+			auto &dropped = getProperty(Lav_RECORDER_DROPPED_BLOCKS);
+			dropped.setIntValue(dropped.getIntValue()+1);
+		}
+		else {
+			interleaveSamples(num_input_buffers, block_size, num_input_buffers, &input_buffers[0], ring+(written%ring_blocks)*block_size*channels);
+			blocks_written.store(written+1, std::memory_order_release);
+		}
 	}
 	for(int i = 0; i < num_output_buffers; i++) std::copy(input_buffers[i], input_buffers[i]+block_size, output_buffers[i]);
 }
 
-void RecorderNode::doMaintenance() {
-	while(available_buffers.size() > buffer_freeing_threshold) freeArray(available_buffers.dequeue());
-}
-
 void RecorderNode::startRecording(std::string path) {
 	if(recording) stopRecording();
+	double duration = getProperty(Lav_RECORDER_BUFFER_DURATION).getDoubleValue();
+	ring_blocks = std::max(2, (int)ceil(duration*simulation->getSr()/block_size));
 	recording_to.open(path.c_str(), simulation->getSr(), channels);
+	ring = allocArray<float>(ring_blocks*block_size*channels);
+	blocks_written.store(0);
+	blocks_read.store(0);
+	getProperty(Lav_RECORDER_DROPPED_BLOCKS).setIntValue(0);
 	recording = true;
-	should_keep_recording.test_and_set(); //so the thread doesn't immediately stop.
+	should_keep_recording.store(true);
 	recording_thread= powercores::safeStartThread(&RecorderNode::recordingThreadFunction, this);
 }
 
 void RecorderNode::stopRecording() {
 	if(recording) {
-		should_keep_recording.clear();
+		//The thread writes whatever is left before exiting.
+		should_keep_recording.store(false);
 		recording_thread.join();
 		recording_to.close();
+		freeArray(ring);
+		ring = nullptr;
 		recording =false;
 	}
 }
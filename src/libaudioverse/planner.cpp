@@ -24,6 +24,7 @@ void Planner::execute(std::shared_ptr<Job> start, int threads) {
 	else initializeStrongPlan(); //Try to get it from the cache.
 	//We might invalidate because of a dead weak pointer, but this can only happen once.
 	if(is_valid == false) replan(start);
+	findBatches();
 	if(threads == 1) {
 		runJobsSync();
 	}
@@ -49,13 +50,35 @@ void jobExecutor(std::shared_ptr<Job> &j) {
 	j->job_recorded = false;
 }
 
-void Planner::runJobsSync() {
-	becomeAudioThread();
+void jobBatchExecutor(std::tuple<std::shared_ptr<Job>*, int> &batch) {
+	auto jobs = std::get<0>(batch);
+	int count = std::get<1>(batch);
+	if(count == 1) jobs[0]->execute();
+	else jobs[0]->executeBatch(jobs, count);
+	for(int i = 0; i < count; i++) jobs[i]->job_recorded = false;
+}
+
+void Planner::findBatches() {
+	//Nothing here allocates once the vectors are big enough.
+	batches.clear();
+	bin_batches.clear();
 	for(auto &bin: plan) {
-		for(auto &j: bin.second) {
-			jobExecutor(j);
+		bin_batches.push_back(batches.size());
+		auto &jobs = bin.second;
+		for(unsigned int i = 0; i < jobs.size();) {
+			int key = jobs[i]->getBatchKey();
+			unsigned int end = i+1;
+			if(key) while(end < jobs.size() && jobs[end]->getBatchKey() == key) end++;
+			batches.emplace_back(&jobs[i], end-i);
+			i = end;
 		}
 	}
+	bin_batches.push_back(batches.size());
+}
+
+void Planner::runJobsSync() {
+	becomeAudioThread();
+	for(auto &batch: batches) jobBatchExecutor(batch);
 	//We are potentially sharing this thread with someone else. It is important that we don't accidentally give them high priority too.
 	unbecomeAudioThread();
 }
@@ -64,8 +87,8 @@ void Planner::runJobsAsync() {
 	//becomeAudioThread is no-op if called multiple times.
 	//Putting it here greatly simplifies thread pool startup logic.
 	thread_pool.submitJobToAllThreads(becomeAudioThread);
-	for(auto &bin: plan) {
-		thread_pool.map(jobExecutor, bin.second.begin(), bin.second.end());
+	for(unsigned int i = 0; i+1 < bin_batches.size(); i++) {
+		thread_pool.map(jobBatchExecutor, batches.begin()+bin_batches[i], batches.begin()+bin_batches[i+1]);
 		thread_pool.submitBarrier();
 	}
 	//At this point, submit a meaningless job that does nothing.
@@ -100,6 +123,12 @@ void Planner::replan(std::shared_ptr<Job> start) {
 	//Fill the vector with the jobs.
 	binner(start, 0, plan);
 	is_valid = true;
+	//Jobs in a bin don't depend on each other, so we can put batchable jobs next to each other.
+	for(auto &bin: plan) {
+		std::stable_sort(bin.second.begin(), bin.second.end(), [] (const std::shared_ptr<Job> &a, const std::shared_ptr<Job> &b) {
+			return a->getBatchKey() < b->getBatchKey();
+		});
+	}
 	//Put in weak_plan, the cache.
 	//We do two loops because we really don't want to keep deleting and recreating the vectors.
 	//First loop: kill bins in the weak plan that have no correspondance anymore.
@@ -0,0 +1,97 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**A process-wide cache of impulse response spectra.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/private/response_cache.hpp>
+#include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/kernels.hpp>
+#include <libaudioverse/private/file.hpp>
+#include <libaudioverse/implementations/convolvers.hpp>
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+//64-bit FNV-1a over the bytes of the response.
+uint64_t hashResponse(int length, float* response) {
+	uint64_t hash = 14695981039346656037ULL;
+	unsigned char* bytes = (unsigned char*)response;
+	for(size_t i = 0; i < length*sizeof(float); i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//Tuple of (hash, length, responseSr, sr, blockSize).
+typedef std::tuple<uint64_t, int, int, int, int> ResponseKey;
+std::map<ResponseKey, std::weak_ptr<ResponseSpectrum>> *response_cache;
+std::mutex *response_cache_mutex;
+
+void initializeResponseCache() {
+	response_cache = new std::map<ResponseKey, std::weak_ptr<ResponseSpectrum>>();
+	response_cache_mutex = new std::mutex();
+}
+
+void shutdownResponseCache() {
+	delete response_cache_mutex;
+	delete response_cache;
+}
+
+std::shared_ptr<ResponseSpectrum> getResponseSpectrum(int length, float* response, int responseSr, int sr, int blockSize) {
+	auto key = std::make_tuple(hashResponse(length, response), length, responseSr, sr, blockSize);
+	{
+		std::lock_guard<std::mutex> guard(*response_cache_mutex);
+		auto i = response_cache->find(key);
+		if(i != response_cache->end()) {
+			auto s = i->second.lock();
+			if(s) return s;
+			response_cache->erase(i);
+		}
+	}
+	//Resampling and transforming is slow, so we don't hold the mutex for it.
+	//If two threads race here, they compute the same thing and the second one wins.
+	std::shared_ptr<ResponseSpectrum> s;
+	if(responseSr == sr) s = std::make_shared<ResponseSpectrum>(length, response, blockSize);
+	else {
+		float* resampled;
+		int resampledLength;
+		staticResamplerKernel(responseSr, sr, 1, length, response, &resampledLength, &resampled);
+		s = std::make_shared<ResponseSpectrum>(resampledLength, resampled, blockSize);
+		delete[] resampled;
+	}
+	std::lock_guard<std::mutex> guard(*response_cache_mutex);
+	//Responses nobody uses anymore would otherwise leave their keys behind forever.
+	//Computing a spectrum costs far more than this sweep.
+	for(auto i = response_cache->begin(); i != response_cache->end();) {
+		if(i->second.expired()) i = response_cache->erase(i);
+		else i++;
+	}
+	(*response_cache)[key] = s;
+	return s;
+}
+
+std::shared_ptr<ResponseSpectrum> getResponseSpectrumFromFile(std::string path, int fileChannel, int sr, int blockSize) {
+	if(fileChannel < 0) ERROR(Lav_ERROR_RANGE, "File channel must be positive.");
+	FileReader reader{};
+	reader.open(path.c_str());
+	if((unsigned int)fileChannel >= reader.getChannelCount()) ERROR(Lav_ERROR_RANGE, "Channel greater than channels in file.");
+	float* tmp = allocArray<float>(reader.getSampleCount());
+	reader.readAll(tmp);
+	//We only care about one channel, so move it to the beginning of the buffer.
+	for(unsigned int i = 0; i < reader.getFrameCount(); i++) tmp[i] = tmp[i*reader.getChannelCount()+fileChannel];
+	auto s = getResponseSpectrum(reader.getFrameCount(), tmp, (int)reader.getSr(), sr, blockSize);
+	freeArray(tmp);
+	return s;
+}
+
+}
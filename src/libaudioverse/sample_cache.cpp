@@ -0,0 +1,187 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**A process-wide cache of decoded, resampled file contents for buffers.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/private/sample_cache.hpp>
+#include <libaudioverse/private/buffer.hpp>
+#include <libaudioverse/private/macros.hpp>
+#include <libaudioverse/private/error.hpp>
+#include <libaudioverse/private/memory.hpp>
+#include <libaudioverse/private/file.hpp>
+#include <libaudioverse/private/utf8.hpp>
+#include <boost/filesystem.hpp>
+#include <stdint.h>
+#include <ctime>
+#include <map>
+#include <list>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <string>
+
+namespace libaudioverse_implementation {
+
+//Tuple of (hash, channels, frames, fileSr, sr, format), where the first four describe the file's decoded samples.
+typedef std::tuple<uint64_t, int, int, int, int, int> SampleContentKey;
+//Tuple of (canonical path, sr, format).
+typedef std::tuple<std::string, int, int> SamplePathKey;
+
+struct SamplePathEntry {
+	uintmax_t size;
+	std::time_t modified;
+	SampleContentKey content;
+};
+
+struct SampleContentEntry {
+	std::shared_ptr<BufferStorage> storage;
+	std::list<SampleContentKey>::iterator lru_position;
+};
+
+std::map<SamplePathKey, SamplePathEntry> *sample_cache_paths;
+std::map<SampleContentKey, SampleContentEntry> *sample_cache_contents;
+//Most recently used at the front.
+std::list<SampleContentKey> *sample_cache_lru;
+std::mutex *sample_cache_mutex;
+long long sample_cache_size = 0;
+long long sample_cache_budget = 128LL*1024*1024;
+
+void initializeSampleCache() {
+	sample_cache_paths = new std::map<SamplePathKey, SamplePathEntry>();
+	sample_cache_contents = new std::map<SampleContentKey, SampleContentEntry>();
+	sample_cache_lru = new std::list<SampleContentKey>();
+	sample_cache_mutex = new std::mutex();
+	sample_cache_size = 0;
+}
+
+void shutdownSampleCache() {
+	delete sample_cache_mutex;
+	delete sample_cache_lru;
+	delete sample_cache_contents;
+	delete sample_cache_paths;
+}
+
+//64-bit FNV-1a over the bytes of the samples.
+uint64_t hashSamples(unsigned int count, float* samples) {
+	uint64_t hash = 14695981039346656037ULL;
+	unsigned char* bytes = (unsigned char*)samples;
+	for(unsigned int i = 0; i < count*sizeof(float); i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//All of the following expect the mutex to be held.
+
+void evictSamplesOverBudget() {
+	while(sample_cache_size > sample_cache_budget && sample_cache_lru->empty() == false) {
+		auto i = sample_cache_contents->find(sample_cache_lru->back());
+		sample_cache_size -= i->second.storage->getMemoryUsage();
+		sample_cache_contents->erase(i);
+		sample_cache_lru->pop_back();
+	}
+	//Path entries pointing at evicted contents are dropped when next looked up.
+}
+
+std::shared_ptr<BufferStorage> findSampleContents(const SampleContentKey &key) {
+	auto i = sample_cache_contents->find(key);
+	if(i == sample_cache_contents->end()) return nullptr;
+	sample_cache_lru->splice(sample_cache_lru->begin(), *sample_cache_lru, i->second.lru_position);
+	return i->second.storage;
+}
+
+void insertSampleContents(const SampleContentKey &key, std::shared_ptr<BufferStorage> storage) {
+	if(storage->getMemoryUsage() > sample_cache_budget) return;
+	sample_cache_lru->push_front(key);
+	(*sample_cache_contents)[key] = SampleContentEntry{storage, sample_cache_lru->begin()};
+	sample_cache_size += storage->getMemoryUsage();
+	evictSamplesOverBudget();
+}
+
+std::shared_ptr<BufferStorage> loadBufferStorageFromFile(std::string path, int sr, int format) {
+	//If any of this fails, FileReader below reports it properly.
+	boost::system::error_code error;
+	bool stamped = false;
+	SamplePathKey pathKey;
+	uintmax_t size = 0;
+	std::time_t modified = 0;
+	auto p = boost::filesystem::canonical(boost::filesystem::path(utf8ToWide(path)), error);
+	if(!error) size = boost::filesystem::file_size(p, error);
+	if(!error) modified = boost::filesystem::last_write_time(p, error);
+	if(!error) {
+		stamped = true;
+		pathKey = std::make_tuple(p.string(), sr, format);
+		std::lock_guard<std::mutex> guard(*sample_cache_mutex);
+		auto i = sample_cache_paths->find(pathKey);
+		if(i != sample_cache_paths->end()) {
+			auto storage = i->second.size == size && i->second.modified == modified ? findSampleContents(i->second.content) : nullptr;
+			if(storage) return storage;
+			sample_cache_paths->erase(i);
+		}
+	}
+	//Decoding and resampling are slow, so we don't hold the mutex for them.
+	//If two threads race here, they compute the same thing and the first one to finish wins.
+	FileReader f{};
+	f.open(path.c_str());
+	int channels = f.getChannelCount(), fileFrames = f.getFrameCount(), fileSr = (int)f.getSr();
+	float* raw = allocArray<float>(f.getSampleCount());
+	f.readAll(raw);
+	auto contentKey = std::make_tuple(hashSamples(f.getSampleCount(), raw), channels, fileFrames, fileSr, sr, format);
+	std::shared_ptr<BufferStorage> storage;
+	{
+		std::lock_guard<std::mutex> guard(*sample_cache_mutex);
+		storage = findSampleContents(contentKey);
+		if(storage && stamped) (*sample_cache_paths)[pathKey] = SamplePathEntry{size, modified, contentKey};
+	}
+	if(storage) {
+		freeArray(raw);
+		return storage;
+	}
+	int frames;
+	float* prepared;
+	try {
+		prepared = prepareBufferData(fileSr, sr, channels, fileFrames, raw, &frames);
+	}
+	catch(...) {
+		freeArray(raw);
+		throw;
+	}
+	freeArray(raw);
+	storage = std::make_shared<BufferStorage>(channels, frames, format, prepared);
+	std::lock_guard<std::mutex> guard(*sample_cache_mutex);
+	auto existing = findSampleContents(contentKey);
+	if(existing) storage = existing;
+	else insertSampleContents(contentKey, storage);
+	if(stamped) (*sample_cache_paths)[pathKey] = SamplePathEntry{size, modified, contentKey};
+	return storage;
+}
+
+void setSampleCacheBudget(long long budget) {
+	std::lock_guard<std::mutex> guard(*sample_cache_mutex);
+	sample_cache_budget = budget;
+	evictSamplesOverBudget();
+}
+
+long long getSampleCacheBudget() {
+	std::lock_guard<std::mutex> guard(*sample_cache_mutex);
+	return sample_cache_budget;
+}
+
+//begin public api
+
+Lav_PUBLIC_FUNCTION LavError Lav_setSampleCacheBudget(int megabytes) {
+	PUB_BEGIN
+	if(megabytes < 0) ERROR(Lav_ERROR_RANGE, "The budget must not be negative.");
+	setSampleCacheBudget(megabytes*1024LL*1024LL);
+	PUB_END
+}
+
+Lav_PUBLIC_FUNCTION LavError Lav_getSampleCacheBudget(int* destination) {
+	PUB_BEGIN
+	*destination = (int)(getSampleCacheBudget()/(1024LL*1024LL));
+	PUB_END
+}
+
+}
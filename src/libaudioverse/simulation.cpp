@@ -23,6 +23,10 @@ A copy of the GPL, as well as other important copyright and licensing informatio
 #include <thread>
 #include <tuple>
 #include <map>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
 
 namespace libaudioverse_implementation {
 
@@ -191,18 +195,99 @@ void Simulation::setBlockCallback(LavBlockCallback callback, void* userdata) {
 	block_callback_userdata=userdata;
 }
 
-void Simulation::writeFile(std::string path, int channels, double duration, bool mayApplyMixingMatrix) {
+/**Offline rendering is a pipeline: this thread renders, using the planner's threads as usual, and a writer thread encodes and writes.
+Blocks are rendered straight into large chunks, which go to the writer as they fill, so the render never waits on the disk unless every chunk is full.*/
+void Simulation::writeFile(std::string path, int channels, double duration, bool mayApplyMixingMatrix, LavWriteFileProgressCallback callback, void* userdata) {
 	int blocks = (duration*getSr()/block_size)+1;
+	//Roughly 64k frames per chunk, and enough chunks that the writer can fall a few behind.
+	const int chunkBlocks = std::max<int>(1, 65536/block_size);
+	const int chunkCount = 4;
+	const int chunkSamples = chunkBlocks*block_size*channels;
 	auto file = FileWriter();
 	file.open(path.c_str(), sr, channels);
 	//vectors are guaranteed to be contiguous. Using a vector here guarantees proper cleanup.
-	std::vector<float> block;
-	block.resize(channels*getBlockSize());
-	for(int i = 0; i < blocks; i++) {
-		getBlock(&block[0], channels, mayApplyMixingMatrix);
-		unsigned int written= 0;
-		while(written < getBlockSize()) written += file.write(getBlockSize(), &block[0]);
+	std::vector<float> chunks;
+	chunks.resize(chunkSamples*chunkCount);
+	//Frames in each chunk; 0 means free.
+	std::vector<int> chunkFrames(chunkCount, 0);
+	std::mutex chunkMutex;
+	std::condition_variable chunkChanged;
+	bool rendering = true;
+	std::exception_ptr writerError = nullptr;
+	std::thread writer([&] () {
+		int current = 0;
+		for(;;) {
+			int frames;
+			{
+				std::unique_lock<std::mutex> guard(chunkMutex);
+				chunkChanged.wait(guard, [&] () {return chunkFrames[current] != 0 || rendering == false;});
+				if(chunkFrames[current] == 0) return;
+				frames = chunkFrames[current];
+			}
+			try {
+				float* data = &chunks[current*chunkSamples];
+				int written = 0;
+				while(written < frames) {
+					int got = file.write(frames-written, data+written*channels);
+					if(got <= 0) ERROR(Lav_ERROR_FILE, "Could not write to the file.");
+					written += got;
+				}
+			}
+			catch(...) {
+				std::lock_guard<std::mutex> guard(chunkMutex);
+				writerError = std::current_exception();
+				chunkChanged.notify_all();
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> guard(chunkMutex);
+				chunkFrames[current] = 0;
+			}
+			chunkChanged.notify_all();
+			current = (current+1)%chunkCount;
+		}
+	});
+	auto stopWriter = [&] () {
+		{
+			std::lock_guard<std::mutex> guard(chunkMutex);
+			rendering = false;
+		}
+		chunkChanged.notify_all();
+		writer.join();
+	};
+	auto startTime = std::chrono::steady_clock::now();
+	auto reportProgress = [&] (int renderedBlocks) {
+		if(callback == nullptr) return;
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+		double frames = (double)renderedBlocks*block_size;
+		callback(outgoingObject(this->shared_from_this()), frames/sr, (double)blocks*block_size/sr, elapsed > 0.0 ? frames/elapsed : 0.0, userdata);
+	};
+	try {
+		int current = 0;
+		for(int i = 0; i < blocks; i += chunkBlocks) {
+			{
+				std::unique_lock<std::mutex> guard(chunkMutex);
+				chunkChanged.wait(guard, [&] () {return chunkFrames[current] == 0 || writerError;});
+				if(writerError) break;
+			}
+			int count = std::min(chunkBlocks, blocks-i);
+			float* data = &chunks[current*chunkSamples];
+			for(int j = 0; j < count; j++) getBlock(data+j*block_size*channels, channels, mayApplyMixingMatrix);
+			{
+				std::lock_guard<std::mutex> guard(chunkMutex);
+				chunkFrames[current] = count*block_size;
+			}
+			chunkChanged.notify_all();
+			current = (current+1)%chunkCount;
+			reportProgress(i+count);
+		}
 	}
+	catch(...) {
+		stopWriter();
+		throw;
+	}
+	stopWriter();
+	if(writerError) std::rethrow_exception(writerError);
 	file.close();
 }
 
@@ -296,6 +381,14 @@ Lav_PUBLIC_FUNCTION LavError Lav_simulationWriteFile(LavHandle simulationHandle,
 	PUB_END
 }
 
+Lav_PUBLIC_FUNCTION LavError Lav_simulationWriteFileWithProgress(LavHandle simulationHandle, const char* path, int channels, double duration, int mayApplyMixingMatrix, LavWriteFileProgressCallback callback, void* userdata) {
+	PUB_BEGIN
+	auto sim = incomingObject<Simulation>(simulationHandle);
+	LOCK(*sim);
+	sim->writeFile(path, channels, duration, mayApplyMixingMatrix, callback, userdata);
+	PUB_END
+}
+
 Lav_PUBLIC_FUNCTION LavError Lav_simulationSetThreads(LavHandle simulationHandle, int threads) {
 	PUB_BEGIN
 	if(threads < 1) ERROR(Lav_ERROR_RANGE, "Cannot run simulation with less than one thread.");
@@ -0,0 +1,44 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**A process-wide cache of bandlimited wavetables.*/
+#include <libaudioverse/private/wavetable_cache.hpp>
+#include <libaudioverse/implementations/wavetable.hpp>
+#include <map>
+#include <utility>
+#include <mutex>
+#include <memory>
+
+namespace libaudioverse_implementation {
+
+//Pair of (waveform, sr).
+typedef std::pair<int, int> WavetableKey;
+std::map<WavetableKey, std::weak_ptr<BandlimitedWavetable>> *wavetable_cache;
+std::mutex *wavetable_cache_mutex;
+
+void initializeWavetableCache() {
+	wavetable_cache = new std::map<WavetableKey, std::weak_ptr<BandlimitedWavetable>>();
+	wavetable_cache_mutex = new std::mutex();
+}
+
+void shutdownWavetableCache() {
+	delete wavetable_cache_mutex;
+	delete wavetable_cache;
+}
+
+std::shared_ptr<BandlimitedWavetable> getBandlimitedWavetable(BandlimitedWaveforms waveform, int sr) {
+	auto key = std::make_pair((int)waveform, sr);
+	//Unlike impulse responses, tables are quick enough to build that we just hold the mutex, which means there's never more than one per key.
+	std::lock_guard<std::mutex> guard(*wavetable_cache_mutex);
+	auto i = wavetable_cache->find(key);
+	if(i != wavetable_cache->end()) {
+		auto t = i->second.lock();
+		if(t) return t;
+	}
+	auto t = std::make_shared<BandlimitedWavetable>(waveform, sr);
+	(*wavetable_cache)[key] = t;
+	return t;
+}
+
+}
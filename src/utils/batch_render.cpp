@@ -0,0 +1,159 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**Renders every scene in a manifest to a file, several at once, and prints how long each took.
+
+The manifest has one scene per line:
+output_path duration channels layer [layer ...]
+Where each layer is a sound file, optionally followed by @gain, which is looped for the whole scene.
+Blank lines and lines starting with # are ignored.  Paths may not contain whitespace.
+
+Each scene gets its own simulation, and scenes are handed out to worker threads as they become free.
+Files loaded by several scenes are only decoded once, thanks to the buffer cache.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#define BLOCK_SIZE 1024
+#define SR 44100
+
+//Unlike the other utilities, this runs on many threads, so failures are reported rather than exiting.
+#define ERRCHECK(x) do {\
+LavError ERRCHECK_result = (x);\
+if(ERRCHECK_result != Lav_ERROR_NONE) {\
+	error = #x " errored: " + std::to_string(ERRCHECK_result);\
+	goto cleanup;\
+}\
+} while(0)\
+
+struct Layer {
+	std::string path;
+	float gain;
+};
+
+struct Scene {
+	int line;
+	std::string output;
+	double duration;
+	int channels;
+	std::vector<Layer> layers;
+};
+
+bool parseManifest(const char* path, std::vector<Scene> &scenes) {
+	std::ifstream file(path);
+	if(file.good() == false) {
+		printf("Could not open %s\n", path);
+		return false;
+	}
+	std::string line;
+	int lineNumber = 0;
+	while(std::getline(file, line)) {
+		lineNumber++;
+		std::istringstream fields(line);
+		Scene scene;
+		scene.line = lineNumber;
+		if(!(fields >> scene.output) || scene.output[0] == '#') continue;
+		if(!(fields >> scene.duration >> scene.channels) || scene.duration <= 0.0 || scene.channels < 1) {
+			printf("Line %i: expected an output path, a positive duration, and a positive channel count.\n", lineNumber);
+			return false;
+		}
+		std::string layer;
+		while(fields >> layer) {
+			auto at = layer.rfind('@');
+			if(at == std::string::npos) scene.layers.push_back({layer, 1.0f});
+			else scene.layers.push_back({layer.substr(0, at), (float)atof(layer.c_str()+at+1)});
+		}
+		if(scene.layers.empty()) {
+			printf("Line %i: scene has no layers.\n", lineNumber);
+			return false;
+		}
+		scenes.push_back(scene);
+	}
+	return true;
+}
+
+//Returns an empty string on success, otherwise a description of what failed.
+std::string renderScene(const Scene &scene) {
+	std::string error;
+	LavHandle simulation = 0;
+	std::vector<LavHandle> handles;
+	ERRCHECK(Lav_createSimulation(SR, BLOCK_SIZE, &simulation));
+	for(auto &layer: scene.layers) {
+		LavHandle buffer, node;
+		ERRCHECK(Lav_createBuffer(simulation, &buffer));
+		handles.push_back(buffer);
+		ERRCHECK(Lav_bufferLoadFromFile(buffer, layer.path.c_str()));
+		ERRCHECK(Lav_createBufferNode(simulation, &node));
+		handles.push_back(node);
+		ERRCHECK(Lav_nodeSetBufferProperty(node, Lav_BUFFER_BUFFER, buffer));
+		ERRCHECK(Lav_nodeSetIntProperty(node, Lav_BUFFER_LOOPING, 1));
+		ERRCHECK(Lav_nodeSetFloatProperty(node, Lav_NODE_MUL, layer.gain));
+		ERRCHECK(Lav_nodeConnectSimulation(node, 0));
+	}
+	ERRCHECK(Lav_simulationWriteFile(simulation, scene.output.c_str(), scene.channels, scene.duration, 1));
+	cleanup:
+	for(auto h: handles) Lav_handleDecRef(h);
+	if(simulation) Lav_handleDecRef(simulation);
+	return error;
+}
+
+int main(int argc, char** args) {
+	if(argc < 2 || argc > 3) {
+		printf("Usage: %s <manifest> [worker_count]\n", args[0]);
+		return 1;
+	}
+	int workerCount = std::thread::hardware_concurrency();
+	if(argc == 3) sscanf(args[2], "%i", &workerCount);
+	if(workerCount < 1) workerCount = 1;
+	std::vector<Scene> scenes;
+	if(parseManifest(args[1], scenes) == false) return 1;
+	if(Lav_initialize() != Lav_ERROR_NONE) {
+		printf("Could not initialize Libaudioverse.\n");
+		return 1;
+	}
+	printf("Rendering %u scenes on %i workers\n", (unsigned int)scenes.size(), workerCount);
+	std::atomic<unsigned int> next{0};
+	std::atomic<int> failures{0};
+	std::mutex printMutex;
+	//Seconds of audio successfully rendered; guarded by printMutex.
+	double audio = 0.0;
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for(int i = 0; i < workerCount; i++) workers.emplace_back([&] () {
+		for(unsigned int s = next++; s < scenes.size(); s = next++) {
+			auto &scene = scenes[s];
+			auto sceneStart = std::chrono::steady_clock::now();
+			auto error = renderScene(scene);
+			double took = std::chrono::duration<double>(std::chrono::steady_clock::now()-sceneStart).count();
+			std::lock_guard<std::mutex> guard(printMutex);
+			if(error.empty()) {
+				printf("%s: %f seconds in %f seconds (%fx realtime)\n", scene.output.c_str(), scene.duration, took, scene.duration/took);
+				audio += scene.duration;
+			}
+			else {
+				printf("%s (line %i) failed: %s\n", scene.output.c_str(), scene.line, error.c_str());
+				failures++;
+			}
+		}
+	});
+	for(auto &w: workers) w.join();
+	double took = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+	Lav_shutdown();
+	printf("Rendered %f seconds of audio in %f seconds: %f scenes per second, %fx realtime\n", audio, took, scenes.size()/took, audio/took);
+	if(failures) {
+		printf("%i scenes failed\n", (int)failures);
+		return 1;
+	}
+	return 0;
+}
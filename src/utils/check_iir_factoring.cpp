@@ -0,0 +1,93 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**Checks that Butterworth lowpasses, whose zeros are all repeated at -1, factor into second-order sections, and that the sections give the same impulse response as the direct form.
+Exits with 1 if any of them fail.
+
+Unlike the other utilities, this uses the implementation directly, since none of it is exported from the library.
+Eighth order at very low frequencies is deliberately left out: in direct form its coefficients don't have enough precision to determine its poles, and the direct form filter is itself unstable.*/
+#include <libaudioverse/implementations/iir.hpp>
+#include <stdio.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+
+using namespace libaudioverse_implementation;
+
+const double pi = 3.14159265358979323846;
+
+//Design a Butterworth lowpass by the bilinear transform, normalized to unity gain at DC.
+void butterworth(int order, double frequency, double sr, std::vector<double> &numerator, std::vector<double> &denominator) {
+	typedef std::complex<double> C;
+	double warped = 2*sr*tan(pi*frequency/sr);
+	std::vector<C> num(1, 1.0), den(1, 1.0);
+	for(int k = 0; k < order; k++) {
+		C pole = warped*std::exp(C(0.0, pi*(2*k+order+1)/(2.0*order)));
+		C z = (2*sr+pole)/(2*sr-pole);
+		std::vector<C> nextNum(num.size()+1, 0.0), nextDen(den.size()+1, 0.0);
+		for(unsigned int i = 0; i < num.size(); i++) {
+			nextNum[i] += num[i];
+			nextNum[i+1] += num[i];
+			nextDen[i] += den[i];
+			nextDen[i+1] -= den[i]*z;
+		}
+		num = nextNum;
+		den = nextDen;
+	}
+	double numSum = 0.0, denSum = 0.0;
+	numerator.clear();
+	denominator.clear();
+	for(auto &c: num) numSum += c.real();
+	for(auto &c: den) denSum += c.real();
+	for(auto &c: num) numerator.push_back(c.real()*denSum/numSum);
+	for(auto &c: den) denominator.push_back(c.real());
+}
+
+bool check(int order, double frequency) {
+	std::vector<double> numerator, denominator;
+	butterworth(order, frequency, 44100, numerator, denominator);
+	double gain;
+	std::vector<IirSection> sections;
+	if(factorIirFilter(numerator.size(), &numerator[0], denominator.size(), &denominator[0], gain, sections) == false) {
+		printf("Order %i at %f HZ: did not factor\n", order, frequency);
+		return false;
+	}
+	//Compare impulse responses, both in double precision.
+	std::vector<double> x(numerator.size(), 0.0), y(denominator.size(), 0.0), s1(sections.size(), 0.0), s2(sections.size(), 0.0);
+	double error = 0.0, peak = 0.0;
+	for(int n = 0; n < 44100; n++) {
+		double input = n == 0 ? 1.0 : 0.0;
+		x.insert(x.begin(), input);
+		x.pop_back();
+		double direct = 0.0;
+		for(unsigned int i = 0; i < numerator.size(); i++) direct += numerator[i]*x[i];
+		for(unsigned int i = 1; i < denominator.size(); i++) direct -= denominator[i]*y[i-1];
+		direct /= denominator[0];
+		y.insert(y.begin(), direct);
+		y.pop_back();
+		double cascaded = input*gain;
+		for(unsigned int i = 0; i < sections.size(); i++) {
+			auto &s = sections[i];
+			double out = s.b0*cascaded+s1[i];
+			s1[i] = s.b1*cascaded-s.a1*out+s2[i];
+			s2[i] = s.b2*cascaded-s.a2*out;
+			cascaded = out;
+		}
+		error = fmax(error, fabs(direct-cascaded));
+		peak = fmax(peak, fabs(direct));
+	}
+	bool passed = error <= 1e-6*peak;
+	printf("Order %i at %f HZ: %u sections, error %g: %s\n", order, frequency, (unsigned int)sections.size(), error, passed ? "passed" : "failed");
+	return passed;
+}
+
+int main(int argc, char** args) {
+	bool passed = true;
+	passed &= check(2, 1000.0);
+	passed &= check(4, 1000.0);
+	passed &= check(8, 1000.0);
+	passed &= check(2, 50.0);
+	passed &= check(4, 50.0);
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**Checks that coefficients an IIR node rejects leave it as it was.
+A sine is filtered by a node running as sections, which is then given a denominator with a leading zero.
+The call must fail, and the node must still sound the same as one which never saw it.
+Exits with 1 on failure.*/
+#include <libaudioverse/libaudioverse.h>
+#include <libaudioverse/libaudioverse_properties.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#define BLOCK_SIZE 1024
+#define SR 44100
+#define BLOCKS 20
+
+#define ERRCHECK(x) do {\
+if((x) != Lav_ERROR_NONE) {\
+	printf(#x " errored: %i\n", (x));\
+	Lav_shutdown();\
+	exit(1);\
+}\
+} while(0)\
+
+//Second order lowpass, which factors into one section.
+double numerator[] = {0.0200833655642112, 0.0401667311284225, 0.0200833655642112};
+double denominator[] = {1.0, -1.5610180758007182, 0.6413515380575631};
+
+//Renders the filtered sine, optionally trying to set rejected coefficients after the first block.
+std::vector<float> render(bool reject, LavError &rejectResult) {
+	std::vector<float> output(BLOCK_SIZE*BLOCKS);
+	LavHandle simulation, sine, iir;
+	ERRCHECK(Lav_createSimulation(SR, BLOCK_SIZE, &simulation));
+	ERRCHECK(Lav_createSineNode(simulation, &sine));
+	ERRCHECK(Lav_createIirNode(simulation, 1, &iir));
+	ERRCHECK(Lav_iirNodeSetCoefficients(iir, 3, numerator, 3, denominator, 1));
+	ERRCHECK(Lav_nodeConnect(sine, 0, iir, 0));
+	ERRCHECK(Lav_nodeConnectSimulation(iir, 0));
+	for(int i = 0; i < BLOCKS; i++) {
+		if(reject && i == 1) {
+			double badDenominator[] = {0.0, 1.0};
+			rejectResult = Lav_iirNodeSetCoefficients(iir, 1, numerator, 2, badDenominator, 0);
+		}
+		ERRCHECK(Lav_simulationGetBlock(simulation, 1, 0, &output[i*BLOCK_SIZE]));
+	}
+	ERRCHECK(Lav_handleDecRef(iir));
+	ERRCHECK(Lav_handleDecRef(sine));
+	ERRCHECK(Lav_handleDecRef(simulation));
+	return output;
+}
+
+int main(int argc, char** args) {
+	ERRCHECK(Lav_initialize());
+	LavError rejectResult = Lav_ERROR_NONE, unused;
+	auto expected = render(false, unused);
+	auto got = render(true, rejectResult);
+	double error = 0.0;
+	for(unsigned int i = 0; i < expected.size(); i++) error = fmax(error, fabs(expected[i]-got[i]));
+	bool passed = rejectResult == Lav_ERROR_RANGE && error == 0.0;
+	printf("Leading zero denominator: result %i, error %g: %s\n", (int)rejectResult, error, passed ? "passed" : "failed");
+	ERRCHECK(Lav_shutdown());
+	return passed ? 0 : 1;
+}
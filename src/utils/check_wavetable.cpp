@@ -0,0 +1,84 @@
+/**Copyright (C) Austin Hicks, 2014
+This file is part of Libaudioverse, a library for 3D and environmental audio simulation, and is released under the terms of the Gnu General Public License Version 3 or (at your option) any later version.
+A copy of the GPL, as well as other important copyright and licensing information, may be found in the file 'LICENSE' in the root of the Libaudioverse repository.  Should this file be missing or unavailable to you, see <http://www.gnu.org/licenses/>.*/
+
+/**Checks WavetableOscillator's block path against its one-sample path, then times it.
+
+Processing one sample at a time always takes the scalar path, so comparing a block with samples computed one at a time from the same phase checks the SIMD path.
+This is done for every waveform at several frequencies, including negative ones, which play the table backwards.
+Exits with 1 if any of them differ by more than single precision rounding.
+
+The timings compare the block path, the one-sample path, and summing the same harmonics with sin per sample.
+As with check_iir_factoring, this uses the implementation directly, since none of it is exported from the library.*/
+#include "time_helper.hpp"
+#include <libaudioverse/implementations/wavetable.hpp>
+#include <stdio.h>
+#include <math.h>
+#include <memory>
+#include <vector>
+
+using namespace libaudioverse_implementation;
+
+#define BLOCK_SIZE 1024
+#define SR 44100
+#define ITERATIONS 2000
+
+const double pi = 3.14159265358979323846;
+const char* waveform_names[] = {"square", "triangle", "saw", "blit"};
+
+bool check(std::shared_ptr<BandlimitedWavetable> table, const char* name, double frequency) {
+	WavetableOscillator block(table, SR), single(table, SR);
+	block.setFrequency(frequency);
+	single.setFrequency(frequency);
+	std::vector<float> output(BLOCK_SIZE);
+	block.process(BLOCK_SIZE, &output[0]);
+	double error = 0.0;
+	for(int i = 0; i < BLOCK_SIZE; i++) {
+		//Start each sample from the exact phase, so that the two paths' phase rounding doesn't accumulate.
+		single.setPhase(i*frequency/SR);
+		float expected;
+		single.process(1, &expected);
+		error = fmax(error, fabs(expected-output[i]));
+	}
+	bool passed = error <= 1e-4;
+	printf("%s at %f HZ: error %g: %s\n", name, frequency, error, passed ? "passed" : "failed");
+	return passed;
+}
+
+void timeOscillator(std::shared_ptr<BandlimitedWavetable> table) {
+	const double frequency = 440.0;
+	WavetableOscillator osc(table, SR);
+	osc.setFrequency(frequency);
+	std::vector<float> output(BLOCK_SIZE);
+	float blockTime = timeit([&] () {
+		osc.process(BLOCK_SIZE, &output[0]);
+	}, ITERATIONS);
+	float singleTime = timeit([&] () {
+		for(int i = 0; i < BLOCK_SIZE; i++) osc.process(1, &output[i]);
+	}, ITERATIONS);
+	//The harmonics the oscillator's table has at this frequency.
+	int harmonics = (int)(SR/2/frequency);
+	double phase = 0.0;
+	float additiveTime = timeit([&] () {
+		for(int i = 0; i < BLOCK_SIZE; i++) {
+			double sum = 0.0;
+			for(int n = 1; n <= harmonics; n += 2) sum += sin(2*pi*n*phase)/n;
+			output[i] = (float)sum;
+			phase += frequency/SR;
+			phase -= floor(phase);
+		}
+	}, ITERATIONS);
+	double seconds = ITERATIONS*BLOCK_SIZE/(double)SR;
+	printf("Realtime oscillators at %f HZ: block %f, one sample at a time %f, %i harmonics summed %f\n", frequency, seconds/blockTime, seconds/singleTime, (harmonics+1)/2, seconds/additiveTime);
+}
+
+int main(int argc, char** args) {
+	bool passed = true;
+	BandlimitedWaveforms waveforms[] = {BandlimitedWaveforms::SQUARE, BandlimitedWaveforms::TRIANGLE, BandlimitedWaveforms::SAW, BandlimitedWaveforms::BLIT};
+	for(int w = 0; w < 4; w++) {
+		auto table = std::make_shared<BandlimitedWavetable>(waveforms[w], SR);
+		for(double frequency: {13.7, 440.0, 5000.0, -13.7, -440.0, -5000.0}) passed &= check(table, waveform_names[w], frequency);
+	}
+	timeOscillator(std::make_shared<BandlimitedWavetable>(BandlimitedWaveforms::SQUARE, SR));
+	return passed ? 0 : 1;
+}
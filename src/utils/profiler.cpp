@@ -60,8 +60,15 @@ LavError createBuffer(LavHandle sim, LavHandle& h) {
 	return Lav_ERROR_NONE;
 }
 
+LavError createStructuredFdn(LavHandle sim, LavHandle& h, int lines, int structure) {
+	ERRCHECK(Lav_createFeedbackDelayNetworkNode(sim, 1.0f, lines, &h));
+	ERRCHECK(Lav_nodeSetIntProperty(h, Lav_FDN_MATRIX_STRUCTURE, structure));
+	return Lav_ERROR_NONE;
+}
+
 std::tuple<std::string, int, std::function<std::vector<LavHandle>(LavHandle, int)>> to_profile[] = {
 ENTRY("sine", 1000, Lav_createSineNode(sim, &h)),
+ENTRY("256-oscillator bank", 10, Lav_createOscillatorBankNode(sim, 256, &h)),
 ENTRY("Blit", 1000, Lav_createBlitNode(sim, &h)),
 ENTRY("4-channel buffer", 100, createBuffer(sim, h)),
 ENTRY("crossfading delay line", 1000, Lav_createCrossfadingDelayNode(sim, 0.1, 1, &h)),
@@ -77,6 +84,9 @@ ENTRY("noise", 100, Lav_createNoiseNode(sim, &h)),
 ENTRY("ringmod", 1000, Lav_createRingmodNode(sim, &h)),
 ENTRY("16x16 FDN", 1, Lav_createFeedbackDelayNetworkNode(sim, 1.0f, 16, &h)),
 ENTRY("32x32 FDN", 1, Lav_createFeedbackDelayNetworkNode(sim, 1.0f, 32, &h)),
+ENTRY("32x32 hadamard FDN", 1, createStructuredFdn(sim, h, 32, Lav_FDN_MATRIX_STRUCTURE_HADAMARD)),
+ENTRY("64x64 hadamard FDN", 1, createStructuredFdn(sim, h, 64, Lav_FDN_MATRIX_STRUCTURE_HADAMARD)),
+ENTRY("64x64 householder FDN", 1, createStructuredFdn(sim, h, 64, Lav_FDN_MATRIX_STRUCTURE_HOUSEHOLDER)),
 };
 int to_profile_size=sizeof(to_profile)/sizeof(to_profile[0]);
 